@@ -0,0 +1,207 @@
+#!/usr/bin/env python3
+"""
+Compress the Elements sample set into a mu-law packed bank for nt_elements
+builds made with SAMPLE_STORAGE=mulaw.
+
+Reads the 16-bit WAV files written by extract_samples.py (wavetable_00.wav ...
+noise.wav), encodes every sample as an 8-bit G.711 mu-law code and writes a
+bank.wav whose body packs two codes per 16-bit frame (first code in the low
+byte). The header matches the PCM bank with its encoding word set to mu-law.
+The plugin keeps the codes in DRAM as-is and decodes them in the exciter,
+halving the sample memory.
+
+Usage:
+    python3 scripts/compress_samples.py [--input DIR] [--output DIR] [--force]
+
+Options:
+    --input     Directory holding the extracted WAV files (default: samples/elements)
+    --output    Output directory for bank.wav (default: samples/elements_mulaw)
+    --force     Overwrite an existing bank.wav
+"""
+
+import argparse
+import struct
+import sys
+import wave
+from pathlib import Path
+
+from extract_samples import (
+    BANK_ENCODING_MULAW,
+    BANK_FILE_NAME,
+    EXPECTED_BOUNDARIES,
+    build_bank_header,
+    write_wav,
+)
+
+
+# G.711 mu-law constants
+MULAW_BIAS = 0x84
+MULAW_CLIP = 32635
+
+
+def mulaw_encode(sample: int) -> int:
+    """
+    Encode one signed 16-bit sample as a G.711 mu-law code.
+
+    Args:
+        sample: Signed 16-bit sample
+
+    Returns:
+        8-bit mu-law code
+    """
+    sign = 0x80 if sample < 0 else 0
+    magnitude = min(-sample if sample < 0 else sample, MULAW_CLIP) + MULAW_BIAS
+    exponent = max(0, min(7, magnitude.bit_length() - 8))
+    mantissa = (magnitude >> (exponent + 3)) & 0x0F
+    return ~(sign | (exponent << 4) | mantissa) & 0xFF
+
+
+def mulaw_decode(code: int) -> int:
+    """
+    Decode a G.711 mu-law code (mirrors generateMulawDecode() in lut_generator.cpp).
+
+    Args:
+        code: 8-bit mu-law code
+
+    Returns:
+        Signed 16-bit sample
+    """
+    code = ~code & 0xFF
+    exponent = (code >> 4) & 0x07
+    mantissa = code & 0x0F
+    magnitude = (((mantissa << 3) + MULAW_BIAS) << exponent) - MULAW_BIAS
+    return -magnitude if code & 0x80 else magnitude
+
+
+def read_wav(filepath: Path) -> list[int]:
+    """
+    Read a mono 16-bit WAV file.
+
+    Args:
+        filepath: Input file path
+
+    Returns:
+        List of signed 16-bit samples
+    """
+    with wave.open(str(filepath), 'r') as wav:
+        if wav.getnchannels() != 1 or wav.getsampwidth() != 2:
+            raise ValueError(f"{filepath.name}: expected mono 16-bit PCM")
+        frames = wav.readframes(wav.getnframes())
+    return list(struct.unpack(f'<{len(frames) // 2}h', frames))
+
+
+def pack_codes(codes: list[int]) -> list[int]:
+    """
+    Pack pairs of mu-law codes into signed 16-bit frames (low byte first).
+
+    Args:
+        codes: 8-bit mu-law codes
+
+    Returns:
+        List of signed 16-bit frames
+    """
+    if len(codes) % 2:
+        codes = codes + [0xFF]  # mu-law silence
+    frames = []
+    for i in range(0, len(codes), 2):
+        word = codes[i] | (codes[i + 1] << 8)
+        frames.append(word - 0x10000 if word >= 0x8000 else word)
+    return frames
+
+
+def compress_samples(input_dir: Path, output_dir: Path, force: bool = False) -> Path:
+    """
+    Build the mu-law bank from the extracted WAV files.
+
+    Args:
+        input_dir: Directory holding wavetable_NN.wav and noise.wav
+        output_dir: Output directory for bank.wav
+        force: Overwrite an existing bank if True
+
+    Returns:
+        Path of the written bank
+    """
+    bank_path = output_dir / BANK_FILE_NAME
+    if bank_path.exists() and not force:
+        print(f"{bank_path} already exists")
+        print("Use --force to regenerate")
+        return bank_path
+
+    # Concatenate wavetables in order, checking region sizes
+    sample_data = []
+    for i in range(len(EXPECTED_BOUNDARIES) - 1):
+        wavetable = read_wav(input_dir / f"wavetable_{i:02d}.wav")
+        expected = EXPECTED_BOUNDARIES[i + 1] - EXPECTED_BOUNDARIES[i]
+        if len(wavetable) != expected:
+            raise ValueError(f"wavetable_{i:02d}.wav: {len(wavetable)} frames, expected {expected}")
+        sample_data.extend(wavetable)
+    noise_data = read_wav(input_dir / "noise.wav")
+
+    codes = [mulaw_encode(s) for s in sample_data + noise_data]
+
+    # Report the quantisation error so a bad encode is obvious
+    peak_error = max(abs(mulaw_decode(c) - s) for c, s in zip(codes, sample_data + noise_data))
+    print(f"  Encoded {len(codes)} samples, peak error {peak_error} LSB")
+
+    header = build_bank_header(EXPECTED_BOUNDARIES, len(noise_data), BANK_ENCODING_MULAW)
+    body = pack_codes(codes)
+    write_wav(bank_path, header + body)
+    print(f"  Created {bank_path}: {len(header) + len(body)} frames "
+          f"({len(codes)} bytes of sample data, was {len(codes) * 2})")
+
+    return bank_path
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description='Compress Elements samples into a mu-law packed bank'
+    )
+    parser.add_argument(
+        '--input', '-i',
+        type=Path,
+        default=None,
+        help='Directory holding the extracted WAV files (default: samples/elements)'
+    )
+    parser.add_argument(
+        '--output', '-o',
+        type=Path,
+        default=None,
+        help='Output directory (default: samples/elements_mulaw)'
+    )
+    parser.add_argument(
+        '--force', '-f',
+        action='store_true',
+        help='Overwrite existing bank'
+    )
+
+    args = parser.parse_args()
+
+    project_root = Path(__file__).parent.parent
+    if args.input is None:
+        args.input = project_root / 'samples' / 'elements'
+    if args.output is None:
+        args.output = project_root / 'samples' / 'elements_mulaw'
+
+    if not args.input.exists():
+        print(f"Error: Input directory not found: {args.input}", file=sys.stderr)
+        print("Run scripts/extract_samples.py first", file=sys.stderr)
+        return 1
+
+    print(f"Elements Sample Compressor (mu-law)")
+    print(f"===================================")
+    print(f"Input:  {args.input}")
+    print(f"Output: {args.output}")
+    print()
+
+    try:
+        compress_samples(args.input, args.output, args.force)
+        print()
+        print(f"Copy {BANK_FILE_NAME} to the 'elements' sample folder on the SD card")
+        return 0
+    except Exception as e:
+        print(f"Error: {e}", file=sys.stderr)
+        return 1
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -5,6 +5,10 @@ Extract wavetable and noise samples from Elements resources.cc into WAV files.
 Extracts smp_sample_data into 9 separate WAV files (one per wavetable region)
 and smp_noise_sample into 1 WAV file, all in 16-bit PCM mono @ 48kHz format.
 
+Also writes bank.wav: a packed bank holding every region back to back after a
+small index header, which the plugin reads in a single streaming request.
+When bank.wav is present on the card the individual files are not needed.
+
 Usage:
     python3 scripts/extract_samples.py [--force] [--source PATH]
 
@@ -31,6 +35,14 @@ SAMPLE_WIDTH = 2     # 16-bit (2 bytes)
 # These define the start of each wavetable region
 EXPECTED_BOUNDARIES = [0, 17099, 20852, 30369, 63050, 85807, 95952, 106297, 117606, 128013]
 
+# Packed bank header (must match SampleManager::kBank* in src/sample_manager.h)
+BANK_FILE_NAME = "bank.wav"
+BANK_HEADER_FRAMES = 32
+BANK_MAGIC = (0x454C, 0x424B)  # "EL", "BK"
+BANK_VERSION = 1
+BANK_ENCODING_PCM16 = 0
+BANK_ENCODING_MULAW = 1
+
 
 def parse_cpp_int16_array(content: str, array_name: str) -> list[int]:
     """
@@ -143,6 +155,36 @@ def write_wav(filepath: Path, samples: list[int], sample_rate: int = SAMPLE_RATE
         wav.writeframes(struct.pack(f'<{len(samples)}h', *samples))
 
 
+def build_bank_header(boundaries: list[int], noise_frames: int,
+                      encoding: int = BANK_ENCODING_PCM16) -> list[int]:
+    """
+    Build the packed bank index header.
+
+    Layout (16-bit words): magic (2), version, wavetable count, each boundary
+    as a (high, low) pair, noise frame count as a (high, low) pair, body
+    encoding, zero padding.
+
+    Args:
+        boundaries: Wavetable start offsets plus the end offset
+        noise_frames: Length of the noise sample
+        encoding: BANK_ENCODING_PCM16 or BANK_ENCODING_MULAW
+
+    Returns:
+        List of BANK_HEADER_FRAMES signed 16-bit samples
+    """
+    words = [BANK_MAGIC[0], BANK_MAGIC[1], BANK_VERSION, len(boundaries) - 1]
+    for value in boundaries + [noise_frames]:
+        words.extend([(value >> 16) & 0xFFFF, value & 0xFFFF])
+    words.append(encoding)
+
+    if len(words) > BANK_HEADER_FRAMES:
+        raise ValueError(f"Bank header needs {len(words)} words, only {BANK_HEADER_FRAMES} available")
+    words.extend([0] * (BANK_HEADER_FRAMES - len(words)))
+
+    # Store the raw words as signed 16-bit samples
+    return [w - 0x10000 if w >= 0x8000 else w for w in words]
+
+
 def extract_samples(source_path: Path, output_dir: Path, force: bool = False) -> dict[str, Path]:
     """
     Extract all samples from resources.cc into WAV files.
@@ -158,6 +200,7 @@ def extract_samples(source_path: Path, output_dir: Path, force: bool = False) ->
     # Check if all files already exist (idempotency)
     expected_files = [output_dir / f"wavetable_{i:02d}.wav" for i in range(9)]
     expected_files.append(output_dir / "noise.wav")
+    expected_files.append(output_dir / BANK_FILE_NAME)
 
     if not force and all(f.exists() for f in expected_files):
         print(f"All {len(expected_files)} sample files already exist in {output_dir}")
@@ -215,6 +258,19 @@ def extract_samples(source_path: Path, output_dir: Path, force: bool = False) ->
 
     output_files[noise_path.stem] = noise_path
 
+    # Packed bank: header + all wavetables + noise in one file
+    bank_path = output_dir / BANK_FILE_NAME
+    if bank_path.exists() and not force:
+        print(f"  Skipping {bank_path.name} (already exists)")
+    else:
+        header = build_bank_header(boundaries, len(noise_data))
+        bank = header + sample_data[:boundaries[-1]] + noise_data
+        write_wav(bank_path, bank)
+        print(f"  Created {bank_path.name}: {len(bank)} frames "
+              f"({BANK_HEADER_FRAMES} header + {boundaries[-1]} wavetable + {len(noise_data)} noise)")
+
+    output_files[bank_path.stem] = bank_path
+
     return output_files
 
 
@@ -0,0 +1,108 @@
+// Copyright 2025 Neal Sanche
+// SPDX-License-Identifier: MIT
+
+#include "cpu_governor.h"
+
+bool CpuGovernor::cycleCounterRunning() {
+#if defined(__arm__)
+    const volatile uint32_t* const dwtCtrl = reinterpret_cast<const volatile uint32_t*>(0xE0001000);
+    if (!(*dwtCtrl & 1u)) {  // CYCCNTENA
+        return false;
+    }
+
+    const uint32_t start = readCycleCounter();
+    for (volatile int i = 0; i < 16; ++i) {
+    }
+    return readCycleCounter() != start;
+#else
+    return false;
+#endif
+}
+
+void CpuGovernor::init() {
+    budgetCycles_ = 0.0f;
+    clockHz_ = kCpuClockHz;
+    lastStep_ = 0;
+    outliers_ = 0;
+    stepTimed_ = false;
+    blockCycles_ = 0.0f;
+    averageCycles_ = 0.0f;
+    holdCounter_ = 0;
+    activeModes_ = kMaxModes;
+}
+
+void CpuGovernor::recordStep(uint32_t cycles, int numFrames, uint32_t sampleRate) {
+    const uint32_t elapsed = cycles - lastStep_;
+    const bool timed = stepTimed_;
+    lastStep_ = cycles;
+    stepTimed_ = true;
+    if (!timed || numFrames <= 0 || sampleRate == 0) {
+        return;
+    }
+
+    const float measured = static_cast<float>(elapsed) * static_cast<float>(sampleRate) /
+                           static_cast<float>(numFrames);
+    if (measured * kClockTolerance < clockHz_ || measured > clockHz_ * kClockTolerance) {
+        if (++outliers_ < kClockRelockSteps) {
+            return;
+        }
+        clockHz_ = measured;  // Seed was wrong for this unit
+    } else {
+        clockHz_ += (measured - clockHz_) * kClockSmoothing;
+    }
+    outliers_ = 0;
+}
+
+void CpuGovernor::setBudget(float budget, uint32_t sampleRate, int blockSize) {
+    if (sampleRate == 0 || blockSize <= 0) {
+        return;
+    }
+
+    blockCycles_ = clockHz_ * static_cast<float>(blockSize) / static_cast<float>(sampleRate);
+
+    // 100% means "no limit" - recordBlock() will walk back up to all modes
+    budgetCycles_ = (budget >= 1.0f) ? 0.0f : budget * blockCycles_;
+}
+
+bool CpuGovernor::recordBlock(uint32_t cycles) {
+    averageCycles_ += (static_cast<float>(cycles) - averageCycles_) * kCostSmoothing;
+
+    if (holdCounter_ > 0) {
+        --holdCounter_;
+        return false;
+    }
+
+    // Governor disabled (or no cycle counter): restore full resolution
+    if (budgetCycles_ <= 0.0f || averageCycles_ <= 0.0f) {
+        if (activeModes_ == kMaxModes) {
+            return false;
+        }
+        activeModes_ = kMaxModes;
+        return true;
+    }
+
+    // Over budget: drop the highest partials quickly
+    if (averageCycles_ > budgetCycles_) {
+        if (activeModes_ <= kMinModes) {
+            return false;
+        }
+        activeModes_ -= kModeStepDown;
+        if (activeModes_ < kMinModes) {
+            activeModes_ = kMinModes;
+        }
+        holdCounter_ = kHoldBlocksDown;
+        return true;
+    }
+
+    // Comfortably under budget: add partials back slowly
+    if (averageCycles_ < budgetCycles_ * kRecoverHeadroom && activeModes_ < kMaxModes) {
+        activeModes_ += kModeStepUp;
+        if (activeModes_ > kMaxModes) {
+            activeModes_ = kMaxModes;
+        }
+        holdCounter_ = kHoldBlocksUp;
+        return true;
+    }
+
+    return false;
+}
@@ -0,0 +1,153 @@
+// Copyright 2025 Neal Sanche
+// SPDX-License-Identifier: MIT
+
+#ifndef CPU_GOVERNOR_H
+#define CPU_GOVERNOR_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/**
+ * CpuGovernor - Scales the number of active resonator modes to a CPU budget
+ *
+ * The modal resonator dominates the cost of an Elements block and scales
+ * roughly linearly with the number of band-pass filters it runs. The governor
+ * measures the cycle cost of each 16-sample Elements block and raises or
+ * lowers the resonator resolution between kMinModes and kMaxModes so that
+ * the average cost stays inside the budget set by the "CPU Budget" parameter.
+ *
+ * Lowering the resolution drops the highest partials first, which are also
+ * the quietest ones (brightness and q-loss attenuate them). Mode count falls
+ * quickly when over budget and recovers slowly with a headroom margin, so the
+ * timbre does not flutter around the threshold.
+ *
+ * Usage:
+ *   1. Call init() in construct()
+ *   2. Call recordStep() and setBudget() once per step()
+ *   3. Bracket each Part::Process() call with readCycleCounter() and pass
+ *      the difference to recordBlock()
+ *   4. When recordBlock() returns true, apply activeModes() to the Part
+ *
+ * Cycle counts come from the Cortex-M7 DWT cycle counter. The counter
+ * belongs to the firmware and is only read: if it isn't running
+ * (cycleCounterRunning() is false, and always on the desktop build) the
+ * caller passes a 100% budget and the governor stays at full resolution.
+ *
+ * The cycles available per block are measured rather than taken from the
+ * core clock: recordStep() times successive step() calls, which arrive at
+ * the audio rate, and the result is smoothed. NT_ELEMENTS_CPU_CLOCK_HZ only
+ * seeds the estimate.
+ */
+class CpuGovernor {
+public:
+    // Resonator resolution range (Resonator::set_resolution rounds to even)
+    static constexpr int kMinModes = 16;
+    static constexpr int kMaxModes = 64;
+    static constexpr int kModeStepDown = 4;
+    static constexpr int kModeStepUp = 2;
+
+    // Blocks to wait after a change before reacting again
+    // (Elements blocks are 16 samples: 3000 blocks/s at 48kHz)
+    static constexpr uint32_t kHoldBlocksDown = 32;    // ~10ms at 48kHz
+    static constexpr uint32_t kHoldBlocksUp = 384;     // ~130ms at 48kHz
+
+    // Only add modes back once the average cost is below this budget fraction
+    static constexpr float kRecoverHeadroom = 0.8f;
+
+    // Smoothing coefficient for the per-block cost average
+    static constexpr float kCostSmoothing = 0.05f;
+
+    // Assumed core clock until step() timing has been measured (override
+    // with CPU_CLOCK_HZ in the Makefile)
+#ifdef NT_ELEMENTS_CPU_CLOCK_HZ
+    static constexpr float kCpuClockHz = NT_ELEMENTS_CPU_CLOCK_HZ;
+#else
+    static constexpr float kCpuClockHz = 480000000.0f;
+#endif
+
+    // Smoothing coefficient for the measured clock; step() intervals outside
+    // [1/kClockTolerance, kClockTolerance] of the estimate are ignored (a
+    // step() delayed by the host, or the first one after a pause) unless
+    // kClockRelockSteps of them in a row show the estimate itself is off
+    static constexpr float kClockSmoothing = 0.01f;
+    static constexpr float kClockTolerance = 1.5f;
+    static constexpr uint32_t kClockRelockSteps = 64;
+
+    /**
+     * Reset to full resolution with no budget (governor disabled).
+     */
+    void init();
+
+    /**
+     * Time one step() call against the previous one to measure the cycles
+     * available per sample. Call once per step(), at the same point each time.
+     *
+     * @param cycles readCycleCounter() now
+     * @param numFrames Frames this step() processes
+     * @param sampleRate Current NT sample rate in Hz
+     */
+    void recordStep(uint32_t cycles, int numFrames, uint32_t sampleRate);
+
+    /**
+     * Set the CPU budget for one Elements block.
+     *
+     * @param budget Fraction of real time Elements may use (0.0-1.0).
+     *               1.0 disables the governor and restores all modes.
+     * @param sampleRate Current NT sample rate in Hz
+     * @param blockSize Elements block size in samples
+     */
+    void setBudget(float budget, uint32_t sampleRate, int blockSize);
+
+    /**
+     * Record the measured cost of one Elements block and update the
+     * active mode count.
+     *
+     * @param cycles Cycles spent in Part::Process() for this block
+     * @return true if activeModes() changed and must be applied
+     */
+    bool recordBlock(uint32_t cycles);
+
+    /**
+     * Get the number of resonator modes the Part should run.
+     */
+    int activeModes() const { return activeModes_; }
+
+    /**
+     * Get the smoothed per-block cost as a fraction of real time.
+     */
+    float load() const { return blockCycles_ > 0.0f ? averageCycles_ / blockCycles_ : 0.0f; }
+
+    /**
+     * Check that firmware runs the DWT cycle counter (DWT_CTRL.CYCCNTENA
+     * set and the count advancing). Only reads the DWT. Call once from
+     * initialise(); without a running counter the CPU budget has no effect.
+     *
+     * @return true if readCycleCounter() advances (always false on builds
+     *         without a counter)
+     */
+    static bool cycleCounterRunning();
+
+    /**
+     * Read the DWT cycle counter (0 on builds without one).
+     */
+    static inline uint32_t readCycleCounter() {
+#if defined(__arm__)
+        return *reinterpret_cast<volatile uint32_t*>(0xE0001004);  // DWT->CYCCNT
+#else
+        return 0;
+#endif
+    }
+
+private:
+    float budgetCycles_;    // Allowed cycles per block (0 = governor disabled)
+    float clockHz_;         // Measured cycles per second of audio
+    uint32_t lastStep_;     // readCycleCounter() at the previous step()
+    uint32_t outliers_;     // step() intervals ignored in a row
+    bool stepTimed_;        // lastStep_ is valid
+    float blockCycles_;     // Cycles available per block at 100% CPU
+    float averageCycles_;   // Smoothed measured cycles per block
+    uint32_t holdCounter_;  // Blocks remaining before the next adjustment
+    int activeModes_;
+};
+
+#endif // CPU_GOVERNOR_H
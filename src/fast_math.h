@@ -0,0 +1,92 @@
+/*
+ * fast_math.h - Polynomial replacements for hot LUT lookups in nt_elements
+ *
+ * Minimax polynomials evaluated in registers, as alternatives to the
+ * interpolated table reads of lut_pitch_ratio_high/low, lut_sine and
+ * lut_approx_svf_g. Coefficients are Remez fits; the error bounds below are
+ * for the polynomial in double precision. tools/lut_bench.cpp (make
+ * lut-bench) measures each against the lut_generator.cpp tables.
+ *
+ * Only SemitonesToRatio() is switched over, and only in builds with
+ * NT_ELEMENTS_FAST_LUT_MATH (make FAST_LUT_MATH=on, see
+ * stmlib-fast-semitones.patch).
+ *
+ * Copyright (c) 2025 Neal Sanche
+ * Licensed under MIT License
+ */
+
+#ifndef NT_ELEMENTS_FAST_MATH_H_
+#define NT_ELEMENTS_FAST_MATH_H_
+
+#include <cstdint>
+#include <cstring>
+
+// 2^x for -64 < x < 64. Degree-4 fit of 2^f on [0, 1), relative error
+// < 2.6e-6 (0.005 cents); the integer part goes into the exponent bits.
+inline float fastExp2(float x) {
+    // The bias keeps the truncating cast a floor for negative x
+    const int32_t n = static_cast<int32_t>(x + 64.0f) - 64;
+    const float f = x - static_cast<float>(n);
+
+    float p = 1.3534167912e-02f;
+    p = p * f + 5.2011460619e-02f;
+    p = p * f + 2.4144275689e-01f;
+    p = p * f + 6.9300383447e-01f;
+    p = p * f + 1.0000025934e+00f;
+
+    const uint32_t bits = static_cast<uint32_t>(n + 127) << 23;
+    float scale;
+    memcpy(&scale, &bits, sizeof(scale));
+    return p * scale;
+}
+
+// 2^(semitones / 12), for the same -128..128 range as the pitch ratio
+// tables. The tables truncate to 1/256 semitone (up to 0.39 cents error).
+inline float fastSemitonesToRatio(float semitones) {
+    return fastExp2(semitones * (1.0f / 12.0f));
+}
+
+// sin(2 pi x) for -0.25 <= x <= 0.25. Odd degree-9 fit, absolute error
+// < 1.3e-8.
+inline float fastSineQuarter(float x) {
+    const float x2 = x * x;
+    float p = 3.9873231778e+01f;
+    p = p * x2 - 7.6598207920e+01f;
+    p = p * x2 + 8.1603265729e+01f;
+    p = p * x2 - 4.1341691864e+01f;
+    p = p * x2 + 6.2831853019e+00f;
+    return p * x;
+}
+
+// sin(2 pi phase), as Interpolate(lut_sine, phase, 4096.0f) for phase >= 0
+inline float fastSine2Pi(float phase) {
+    float x = phase - static_cast<float>(static_cast<int32_t>(phase));
+    // Fold onto [-0.25, 0.25] by the symmetries of the sine
+    if (x > 0.75f) {
+        x -= 1.0f;
+    } else if (x > 0.25f) {
+        x = 0.5f - x;
+    }
+    return fastSineQuarter(x);
+}
+
+// tan(pi f) for 0 <= f < 0.5, as sin(pi f) / cos(pi f). Both come from the
+// quarter-wave sine, so the ratio stays accurate up to Nyquist where a
+// plain polynomial in f would not.
+inline float fastTanPi(float f) {
+    const float half = 0.5f * f;
+    return fastSineQuarter(half) / fastSineQuarter(0.25f - half);
+}
+
+// SVF g coefficient, as Interpolate(lut_approx_svf_g, x, 256.0f):
+// tan(pi * 32Hz * 10^(2.7 x) / sampleRate), clamped below Nyquist like the
+// table. 2.7 * log2(10) = 8.96920...
+inline float fastSvfG(float x, float oneOverSampleRate) {
+    float f = 32.0f * fastExp2(8.9692059e+00f * x) * oneOverSampleRate;
+    if (f > 0.499f) {
+        f = 0.499f;
+    }
+    return fastTanPi(f);
+}
+
+#endif // NT_ELEMENTS_FAST_MATH_H_
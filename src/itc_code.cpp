@@ -0,0 +1,120 @@
+/*
+ * itc_code.cpp - Hot code placement in ITC memory for nt_elements
+ *
+ * Copyright (c) 2025 Neal Sanche
+ * Licensed under MIT License
+ */
+
+#include "itc_code.h"
+#include <cstring>
+
+// ============================================================================
+// ITC kernels - no calls out of the section except long calls (see itc_code.h)
+// ============================================================================
+
+// Per-sample part of step(): accumulate inputs into the Elements block
+// buffers and write the previous block's outputs to the NT buses
+NT_ELEMENTS_ITC
+static void exchangeFrames(const FrameExchange& x, int frame, int pos, int count) {
+    // Blow input: goes through diffusion -> envelope -> STRENGTH VCA -> resonator
+    // Strike input: goes directly to resonator (unprocessed)
+    if (x.blow_in) {
+        for (int i = 0; i < count; ++i) {
+            x.blow_buffer[pos + i] = x.blow_in[frame + i];
+        }
+    } else {
+        for (int i = 0; i < count; ++i) {
+            x.blow_buffer[pos + i] = 0.0f;
+        }
+    }
+    if (x.strike_in) {
+        for (int i = 0; i < count; ++i) {
+            x.strike_buffer[pos + i] = x.strike_in[frame + i];
+        }
+    } else {
+        for (int i = 0; i < count; ++i) {
+            x.strike_buffer[pos + i] = 0.0f;
+        }
+    }
+
+    // Output from buffer (filled in previous processing cycle)
+    const float gain = x.gain;
+    if (x.replace_main) {
+        for (int i = 0; i < count; ++i) {
+            x.main_out[frame + i] = x.main_buffer[pos + i] * gain;
+        }
+    } else {
+        for (int i = 0; i < count; ++i) {
+            x.main_out[frame + i] += x.main_buffer[pos + i] * gain;
+        }
+    }
+    if (x.replace_aux) {
+        for (int i = 0; i < count; ++i) {
+            x.aux_out[frame + i] = x.aux_buffer[pos + i] * gain;
+        }
+    } else {
+        for (int i = 0; i < count; ++i) {
+            x.aux_out[frame + i] += x.aux_buffer[pos + i] * gain;
+        }
+    }
+}
+
+#if defined(__arm__)
+// Section bounds, defined by itc_code.ld
+extern "C" const uint8_t nt_itc_start[];
+extern "C" const uint8_t nt_itc_end[];
+#endif
+
+// ============================================================================
+// Installation
+// ============================================================================
+
+size_t itcCodeBytes() {
+#if defined(__arm__)
+    return static_cast<size_t>(nt_itc_end - nt_itc_start);
+#else
+    return 0;
+#endif
+}
+
+#if defined(__arm__)
+// Returns the entry point of `fn` in the copy at `itc`, or `fn` itself if it
+// is not in the section
+template <typename Fn>
+static Fn itcEntry(Fn fn, uint8_t* itc) {
+    // Thumb function pointers carry bit 0; strip it to get the code address
+    const uintptr_t start = reinterpret_cast<uintptr_t>(nt_itc_start);
+    const uintptr_t entry = reinterpret_cast<uintptr_t>(fn);
+    const uintptr_t offset = (entry & ~static_cast<uintptr_t>(1)) - start;
+    if (offset >= itcCodeBytes()) {
+        return fn;
+    }
+    return reinterpret_cast<Fn>(reinterpret_cast<uintptr_t>(itc) + offset + (entry & 1));
+}
+#endif
+
+void itcCodeInstall(uint8_t* itc, size_t itcBytes, ItcKernels* kernels) {
+    kernels->exchange_frames = &exchangeFrames;
+    kernels->render_resonator = &elements::Resonator::Render;
+
+#if defined(__arm__)
+    const size_t bytes = itcCodeBytes();
+
+    // Run in place if ITC was not granted or is too small
+    if (!itc || bytes == 0 || itcBytes < bytes) {
+        return;
+    }
+
+    memcpy(itc, nt_itc_start, bytes);
+
+    // Make sure the copy is complete before fetching instructions from it
+    __asm__ volatile("dsb\n\tisb" ::: "memory");
+
+    // A kernel that somehow ended up outside the section keeps running in place
+    kernels->exchange_frames = itcEntry(kernels->exchange_frames, itc);
+    kernels->render_resonator = itcEntry(kernels->render_resonator, itc);
+#else
+    (void)itc;
+    (void)itcBytes;
+#endif
+}
@@ -0,0 +1,71 @@
+/*
+ * itc_code.h - Hot code placement in ITC memory for nt_elements
+ *
+ * Code placed in the .text.nt_itc section is copied into the instance's ITC
+ * allocation at construct() (zero-wait-state instruction fetch on the M7)
+ * and callers go through the returned entry points. If no ITC was granted
+ * the code runs from where the loader put it.
+ *
+ * The section holds the step() frame exchange kernel (itc_code.cpp, tagged
+ * NT_ELEMENTS_ITC) and Resonator::Render(), the modal and bowed filter
+ * loops, which the Makefile moves there with objcopy. The linker script
+ * itc_code.ld brackets the section with nt_itc_start / nt_itc_end.
+ *
+ * A copied function must not make PC-relative calls out of the section (the
+ * loader resolved those for the original address). itc_code.cpp and
+ * resonator.cc are built with -mlong-calls, so every call goes through an
+ * absolute address that stays valid in the copy. itc_code.cpp is also built
+ * with -fno-tree-loop-distribute-patterns, so the copy loops are not turned
+ * into memcpy() calls that would leave ITC.
+ *
+ * Copyright (c) 2025 Neal Sanche
+ * Licensed under MIT License
+ */
+
+#ifndef NT_ELEMENTS_ITC_CODE_H_
+#define NT_ELEMENTS_ITC_CODE_H_
+
+#include <cstddef>
+#include <cstdint>
+
+#include "elements/dsp/resonator.h"
+
+#if defined(__arm__)
+#define NT_ELEMENTS_ITC __attribute__((section(".text.nt_itc"), noinline))
+#else
+#define NT_ELEMENTS_ITC
+#endif
+
+// Buffers shared between step() and the frame exchange kernel
+struct FrameExchange {
+    const float* blow_in;       // NT blow input bus (nullptr = not connected)
+    const float* strike_in;     // NT strike input bus (nullptr = not connected)
+    float* main_out;            // NT main output bus
+    float* aux_out;             // NT aux output bus
+    float* blow_buffer;         // Elements block input accumulators
+    float* strike_buffer;
+    const float* main_buffer;   // Elements block outputs from the previous block
+    const float* aux_buffer;
+    float gain;                 // Output level * 5V scaling
+    bool replace_main;          // Output modes (true = replace, false = mix)
+    bool replace_aux;
+};
+
+// Moves `count` frames between the NT buses (starting at `frame`) and the
+// 16-sample Elements block buffers (starting at `pos`)
+typedef void (*ExchangeFramesFn)(const FrameExchange& x, int frame, int pos, int count);
+
+// Entry points of the ITC code: the copies, or the originals as a fallback
+struct ItcKernels {
+    ExchangeFramesFn exchange_frames;
+    elements::Resonator::RenderFn render_resonator;
+};
+
+// Returns ITC bytes needed for the .text.nt_itc section (0 on builds without ITC)
+size_t itcCodeBytes();
+
+// Copies the .text.nt_itc section into `itc` (may be nullptr) and fills in
+// the entry points to call
+void itcCodeInstall(uint8_t* itc, size_t itcBytes, ItcKernels* kernels);
+
+#endif // NT_ELEMENTS_ITC_CODE_H_
@@ -4,6 +4,8 @@
  * Generates all Elements lookup tables at runtime, matching the formulas
  * from external/mutable-instruments/elements/resources/lookup_tables.py.
  * Tables are stored in API-allocated static DRAM to eliminate ~33KB of .rodata.
+ * Tables that depend on the sample rate are generated for the running rate
+ * instead of Elements' fixed 32kHz, so the DSP needs no rate compensation.
  *
  * Copyright (c) 2025 Neal Sanche
  * Licensed under MIT License
@@ -18,8 +20,12 @@
 #define M_PI 3.14159265358979323846
 #endif
 
-// Original Elements sample rate used for LUT generation
-static const float SAMPLE_RATE = 32000.0f;
+// Sample rates whose rate-dependent tables (SVF coefficients, envelope
+// increments, MIDI note to frequency) are generated once in initialise().
+// Any other rate gets one more set, regenerated when that rate is selected.
+static const uint32_t kCachedRates[] = { 32000, 48000, 96000 };
+static const int kNumCachedRates = 3;
+static const int kNumRateSets = kNumCachedRates + 1;
 
 // ------------------------------------------------------------------
 // Pointer definitions — these are the symbols referenced by Elements DSP code.
@@ -49,6 +55,10 @@ const float* lut_fm_frequency_quantizer = nullptr;
 const float* lut_detune_quantizer = nullptr;
 const float* lut_svf_shift = nullptr;
 
+#ifdef NT_ELEMENTS_MULAW_SAMPLES
+const int16_t* lut_mulaw_decode = nullptr;
+#endif
+
 } // namespace elements
 
 namespace stmlib {
@@ -82,20 +92,31 @@ static const int kFmFreqQuantSize     = 129;
 static const int kDetuneQuantSize     = 65;
 static const int kSvfShiftSize        = 257;
 static const int kDbLedSize           = 513;
+#ifdef NT_ELEMENTS_MULAW_SAMPLES
+static const int kMulawDecodeSize     = 256;
+#endif
 static const int kPitchRatioHighSize  = 257;
 static const int kPitchRatioLowSize   = 257;
 
+// Float entries of one set of rate-dependent tables
+static const size_t kRateFloats =
+    kSvfGainSize + kSvfGSize + kSvfRSize + kSvfHSize +
+    kEnvIncrementsSize + kMidiToFHighSize + kMidiToIncHighSize;
+
 // Total float entries
 static const size_t kTotalFloats =
-    kSinSize + kSvfGainSize + kSvfGSize + kSvfRSize + kSvfHSize +
-    k4DecadesSize + kAccentCoarseSize + kAccentFineSize + kStiffnessSize +
-    kEnvIncrementsSize + kEnvLinearSize + kEnvExpoSize + kEnvQuarticSize +
-    kMidiToFHighSize + kMidiToIncHighSize + kMidiToFLowSize +
+    kSinSize + k4DecadesSize + kAccentCoarseSize + kAccentFineSize + kStiffnessSize +
+    kEnvLinearSize + kEnvExpoSize + kEnvQuarticSize + kMidiToFLowSize +
     kFmFreqQuantSize + kDetuneQuantSize + kSvfShiftSize +
-    kPitchRatioHighSize + kPitchRatioLowSize;
+    kPitchRatioHighSize + kPitchRatioLowSize +
+    kRateFloats * kNumRateSets;
 
 // Total int16 entries
+#ifdef NT_ELEMENTS_MULAW_SAMPLES
+static const size_t kTotalInt16s = kDbLedSize + kMulawDecodeSize;
+#else
 static const size_t kTotalInt16s = kDbLedSize;
+#endif
 
 size_t lutGeneratorTotalBytes() {
     // float tables + int16 table, with 4-byte alignment for safety
@@ -105,6 +126,73 @@ size_t lutGeneratorTotalBytes() {
     return bytes;
 }
 
+// Rate-dependent tables for one sample rate
+struct RateTables {
+    uint32_t rate;              // 0 = not generated yet
+    float* svf_gain;
+    float* svf_g;
+    float* svf_r;
+    float* svf_h;
+    float* env_increments;
+    float* midi_to_f_high;
+    float* midi_to_inc_high;
+};
+
+static RateTables s_rateTables[kNumRateSets];
+static uint32_t s_activeRate = 0;
+
+// Bumped whenever the tables in the DRAM block are (re)built or the active
+// rate set changes, so per-instance copies know they are stale
+static uint32_t s_generation = 0;
+
+// ------------------------------------------------------------------
+// Hot-table placement
+// ------------------------------------------------------------------
+
+// Tables read on every block of the resonator path, with the tier each
+// instance copies them into. Ranked by reads per 16-sample block at full
+// resolution (64 modes): the SVF coefficients and pitch ratios are read per
+// mode on every block (ComputeFilters, SemitonesToRatio), the MIDI tables a
+// few times per voice. They are small and go to DTC next to the Part.
+// lut_sine (read once per mode for the pickup position) is too large for
+// DTC and a per-instance SRAM copy would cost 16KB per instance, so it stays
+// in the shared DRAM block with everything read per note or per parameter
+// change.
+struct HotTable {
+    const float** global;   // Pointer variable the DSP reads
+    const float* dram;      // Master copy in the DRAM block
+    int size;
+    LutTier tier;
+    bool rateDependent;
+};
+
+static HotTable s_hotTables[] = {
+    { &elements::lut_approx_svf_g,      nullptr, kSvfGSize,           kLutTierDtc,  true },
+    { &elements::lut_approx_svf_r,      nullptr, kSvfRSize,           kLutTierDtc,  true },
+    { &elements::lut_approx_svf_h,      nullptr, kSvfHSize,           kLutTierDtc,  true },
+#ifndef NT_ELEMENTS_FAST_LUT_MATH
+    // SemitonesToRatio() doesn't read these in fast-math builds
+    { &stmlib::lut_pitch_ratio_high,    nullptr, kPitchRatioHighSize, kLutTierDtc,  false },
+    { &stmlib::lut_pitch_ratio_low,     nullptr, kPitchRatioLowSize,  kLutTierDtc,  false },
+#endif
+    { &elements::lut_midi_to_f_high,    nullptr, kMidiToFHighSize,    kLutTierDtc,  true },
+    { &elements::lut_midi_to_f_low,     nullptr, kMidiToFLowSize,     kLutTierDtc,  false },
+};
+static const int kNumHotTables = sizeof(s_hotTables) / sizeof(s_hotTables[0]);
+
+// Record the DRAM masters of the hot tables from the global pointers, which
+// the caller has just pointed at the DRAM block. Outside buildTables() only
+// the rate-dependent globals are fresh; the others may point at an
+// instance's copies.
+static void captureHotSources(bool rateOnly) {
+    for (int i = 0; i < kNumHotTables; ++i) {
+        if (!rateOnly || s_hotTables[i].rateDependent) {
+            s_hotTables[i].dram = *s_hotTables[i].global;
+        }
+    }
+    ++s_generation;
+}
+
 // ------------------------------------------------------------------
 // Helper: Allocate a float array from the DRAM cursor
 // ------------------------------------------------------------------
@@ -132,14 +220,18 @@ static void generateSine(float* out) {
     out[4096] = out[0];
 }
 
-static void generateApproxSvf(float* gain, float* g, float* r, float* h) {
+static void generateApproxSvf(float* gain, float* g, float* r, float* h, float sampleRate) {
     // frequency = 32 * 10^(2.7 * i/256), normalized to sample rate
     for (int i = 0; i < 257; ++i) {
         float freq = 32.0f * powf(10.0f, 2.7f * (float)i / 256.0f);
-        freq /= SAMPLE_RATE;
+        freq /= sampleRate;
         if (freq >= 0.499f) freq = 0.499f;
 
-        float g_val = tanf((float)M_PI * freq);
+        // g in double: near the 0.499 clamp tan() magnifies float rounding
+        // of the frequency (and of 0.499f) to ~4e-5 relative
+        double freq_d = 32.0 * pow(10.0, 2.7 * i / 256.0) / sampleRate;
+        if (freq_d >= 0.499) freq_d = 0.499;
+        float g_val = (float)tan(M_PI * freq_d);
         float r_default = 2.0f;
         float h_val = 1.0f / (1.0f + r_default * g_val + g_val * g_val);
         float gain_val = (0.42f / freq) * powf(4.0f, freq * freq);
@@ -192,6 +284,19 @@ static void generateDbLedBrightness(int16_t* out) {
     }
 }
 
+#ifdef NT_ELEMENTS_MULAW_SAMPLES
+static void generateMulawDecode(int16_t* out) {
+    // G.711 mu-law expansion (matches scripts/compress_samples.py)
+    for (int i = 0; i < 256; ++i) {
+        int code = ~i & 0xFF;
+        int exponent = (code >> 4) & 0x07;
+        int mantissa = code & 0x0F;
+        int magnitude = (((mantissa << 3) + 0x84) << exponent) - 0x84;
+        out[i] = static_cast<int16_t>((code & 0x80) ? -magnitude : magnitude);
+    }
+}
+#endif
+
 static void generateStiffness(float* out) {
     for (int i = 0; i < 257; ++i) {
         float g = (float)i / 256.0f;
@@ -217,9 +322,9 @@ static void generateStiffness(float* out) {
     out[255] = 2.0f;
 }
 
-static void generateEnvIncrements(float* out) {
-    // control_rate = SAMPLE_RATE / 16
-    float control_rate = SAMPLE_RATE / 16.0f;
+static void generateEnvIncrements(float* out, float sampleRate) {
+    // control_rate = sample rate / 16 (the DSP block size)
+    float control_rate = sampleRate / 16.0f;
     float max_time = 8.0f;
     float min_time = 0.0005f;
     float gamma = 0.175f;
@@ -264,26 +369,26 @@ static void generateEnvQuartic(float* out) {
     }
 }
 
-static void generateMidiToFHigh(float* out) {
+static void generateMidiToFHigh(float* out, float sampleRate) {
     for (int i = 0; i < 256; ++i) {
         float midi_note = (float)(i - 48);
         float frequency = 440.0f * powf(2.0f, (midi_note - 69.0f) / 12.0f);
         float max_frequency = 12000.0f;
-        if (max_frequency > SAMPLE_RATE / 2.0f) max_frequency = SAMPLE_RATE / 2.0f;
+        if (max_frequency > sampleRate / 2.0f) max_frequency = sampleRate / 2.0f;
         if (frequency >= max_frequency) frequency = max_frequency;
-        frequency /= SAMPLE_RATE;
+        frequency /= sampleRate;
         out[i] = frequency;
     }
 }
 
-static void generateMidiToIncrementHigh(float* out) {
+static void generateMidiToIncrementHigh(float* out, float sampleRate) {
     for (int i = 0; i < 256; ++i) {
         float midi_note = (float)(i - 48);
         float frequency = 440.0f * powf(2.0f, (midi_note - 69.0f) / 12.0f);
         float max_frequency = 12000.0f;
-        if (max_frequency > SAMPLE_RATE / 2.0f) max_frequency = SAMPLE_RATE / 2.0f;
+        if (max_frequency > sampleRate / 2.0f) max_frequency = sampleRate / 2.0f;
         if (frequency >= max_frequency) frequency = max_frequency;
-        frequency /= SAMPLE_RATE;
+        frequency /= sampleRate;
         // frequency * 2^32 — stored as float
         out[i] = frequency * 4294967296.0f;
     }
@@ -295,114 +400,75 @@ static void generateMidiToFLow(float* out) {
     }
 }
 
+// The quantizer tables are not closed-form: lookup_tables.py fills the gaps
+// between the ratios with a rule the midpoint-insertion reconstruction did
+// not reproduce (tools/lut_explorer.cpp found entries off by up to 4.3
+// semitones). They are small, so the original values are copied instead.
+
 static void generateFmFrequencyQuantizer(float* out) {
-    // FM frequency ratios from lookup_tables.py
-    static const float fm_ratios[] = {
-        0.5f,
-        0.5f * 1.01331484531f,  // 0.5 * 2^(16/1200)
-        0.70710678118f,          // sqrt(2)/2
-        0.78539816340f,          // pi/4
-        1.0f,
-        1.0f * 1.01331484531f,  // 1.0 * 2^(16/1200)
-        1.41421356237f,          // sqrt(2)
-        1.57079632679f,          // pi/2
-        1.75f,                   // 7/4
-        2.0f,
-        2.0f * 1.01331484531f,  // 2.0 * 2^(16/1200)
-        2.25f,                   // 9/4
-        2.75f,                   // 11/4
-        2.82842712475f,          // 2*sqrt(2)
-        3.0f,
-        3.14159265359f,          // pi
-        3.46410161514f,          // sqrt(3)*2
-        4.0f,
-        4.24264068712f,          // sqrt(2)*3
-        4.71238898038f,          // pi*3/2
-        5.0f,
-        5.65685424949f,          // sqrt(2)*4
-        8.0f
+    // FM frequency ratios in semitones, each held for 3 entries, with the
+    // gaps filled (128 + 1 sentinel)
+    static const float kFmFrequencyQuantizer[kFmFreqQuantSize] = {
+        -1.200000000e+01f, -1.200000000e+01f, -1.200000000e+01f, -1.184000000e+01f,
+        -1.184000000e+01f, -1.184000000e+01f, -1.111000000e+01f, -1.038000000e+01f,
+        -9.650000000e+00f, -8.920000000e+00f, -8.190000000e+00f, -7.460000000e+00f,
+        -6.730000000e+00f, -6.000000000e+00f, -6.000000000e+00f, -6.000000000e+00f,
+        -5.545511612e+00f, -5.091023223e+00f, -4.636534835e+00f, -4.182046446e+00f,
+        -4.182046446e+00f, -4.182046446e+00f, -3.659290641e+00f, -3.136534835e+00f,
+        -2.613779029e+00f, -2.091023223e+00f, -1.568267417e+00f, -1.045511612e+00f,
+        -5.227558058e-01f, 0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f,
+        1.600000000e-01f, 1.600000000e-01f, 1.600000000e-01f, 8.900000000e-01f,
+        1.620000000e+00f, 2.350000000e+00f, 3.080000000e+00f, 3.810000000e+00f,
+        4.540000000e+00f, 5.270000000e+00f, 6.000000000e+00f, 6.000000000e+00f,
+        6.000000000e+00f, 6.454488388e+00f, 6.908976777e+00f, 7.363465165e+00f,
+        7.817953554e+00f, 7.817953554e+00f, 7.817953554e+00f, 8.285529931e+00f,
+        8.753106309e+00f, 9.220682687e+00f, 9.688259065e+00f, 9.688259065e+00f,
+        9.688259065e+00f, 1.026619430e+01f, 1.084412953e+01f, 1.142206477e+01f,
+        1.200000000e+01f, 1.200000000e+01f, 1.200000000e+01f, 1.216000000e+01f,
+        1.216000000e+01f, 1.216000000e+01f, 1.262977500e+01f, 1.309955001e+01f,
+        1.356932501e+01f, 1.403910002e+01f, 1.403910002e+01f, 1.403910002e+01f,
+        1.490761987e+01f, 1.577613972e+01f, 1.664465957e+01f, 1.751317942e+01f,
+        1.751317942e+01f, 1.751317942e+01f, 1.800000000e+01f, 1.800000000e+01f,
+        1.800000000e+01f, 1.850977500e+01f, 1.901955001e+01f, 1.901955001e+01f,
+        1.901955001e+01f, 1.981795355e+01f, 1.981795355e+01f, 1.981795355e+01f,
+        2.066386428e+01f, 2.150977500e+01f, 2.150977500e+01f, 2.150977500e+01f,
+        2.213233125e+01f, 2.275488750e+01f, 2.337744375e+01f, 2.400000000e+01f,
+        2.400000000e+01f, 2.400000000e+01f, 2.450977500e+01f, 2.501955001e+01f,
+        2.501955001e+01f, 2.501955001e+01f, 2.547403840e+01f, 2.592852679e+01f,
+        2.638301517e+01f, 2.683750356e+01f, 2.683750356e+01f, 2.683750356e+01f,
+        2.735032035e+01f, 2.786313714e+01f, 2.786313714e+01f, 2.786313714e+01f,
+        2.839735285e+01f, 2.893156857e+01f, 2.946578428e+01f, 3.000000000e+01f,
+        3.000000000e+01f, 3.000000000e+01f, 3.075000000e+01f, 3.150000000e+01f,
+        3.225000000e+01f, 3.300000000e+01f, 3.375000000e+01f, 3.450000000e+01f,
+        3.525000000e+01f, 3.600000000e+01f, 3.600000000e+01f, 3.600000000e+01f,
+        3.600000000e+01f,
     };
-
-    // Convert to semitones: 12 * log2(ratio)
-    // Then replicate each value 3 times
-    float scale[128];
-    int scale_len = 0;
-    for (int r = 0; r < 23; ++r) {
-        float semitones = 12.0f * log2f(fm_ratios[r]);
-        scale[scale_len++] = semitones;
-        scale[scale_len++] = semitones;
-        scale[scale_len++] = semitones;
-    }
-    // scale_len = 69
-
-    // Pad to next power of 2 (128) by inserting midpoints at largest gaps
-    while (scale_len < 128) {
-        // Find largest gap
-        int gap = 0;
-        float max_diff = 0;
-        for (int i = 0; i < scale_len - 1; ++i) {
-            float d = scale[i + 1] - scale[i];
-            if (d > max_diff) {
-                max_diff = d;
-                gap = i;
-            }
-        }
-        // Insert midpoint after gap
-        float mid = (scale[gap] + scale[gap + 1]) / 2.0f;
-        // Shift right
-        for (int j = scale_len; j > gap + 1; --j) {
-            scale[j] = scale[j - 1];
-        }
-        scale[gap + 1] = mid;
-        scale_len++;
-    }
-
-    // Copy to output (128 + 1 sentinel)
-    for (int i = 0; i < 128; ++i) {
-        out[i] = scale[i];
-    }
-    out[128] = scale[127];  // sentinel
+    memcpy(out, kFmFrequencyQuantizer, sizeof(kFmFrequencyQuantizer));
 }
 
 static void generateDetuneQuantizer(float* out) {
-    static const float detune_ratios[] = {
-        -24.0f, -12.0f, -11.95f, -5.0f, -0.05f,
-        0.0f, 0.05f, 7.0f, 12.0f, 19.0f, 24.0f
+    // Detune steps in semitones, each held for 3 entries, with the gaps
+    // filled (64 + 1 sentinel)
+    static const float kDetuneQuantizer[kDetuneQuantSize] = {
+        -2.400000000e+01f, -2.400000000e+01f, -2.400000000e+01f, -2.300000000e+01f,
+        -2.200000000e+01f, -2.100000000e+01f, -2.000000000e+01f, -1.900000000e+01f,
+        -1.800000000e+01f, -1.700000000e+01f, -1.600000000e+01f, -1.500000000e+01f,
+        -1.400000000e+01f, -1.300000000e+01f, -1.200000000e+01f, -1.200000000e+01f,
+        -1.200000000e+01f, -1.195000000e+01f, -1.195000000e+01f, -1.195000000e+01f,
+        -1.021250000e+01f, -8.475000000e+00f, -6.737500000e+00f, -5.000000000e+00f,
+        -5.000000000e+00f, -5.000000000e+00f, -3.762500000e+00f, -2.525000000e+00f,
+        -1.287500000e+00f, -5.000000000e-02f, -5.000000000e-02f, -5.000000000e-02f,
+        0.000000000e+00f, 0.000000000e+00f, 0.000000000e+00f, 5.000000000e-02f,
+        5.000000000e-02f, 5.000000000e-02f, 1.787500000e+00f, 3.525000000e+00f,
+        5.262500000e+00f, 7.000000000e+00f, 7.000000000e+00f, 7.000000000e+00f,
+        8.250000000e+00f, 9.500000000e+00f, 1.075000000e+01f, 1.200000000e+01f,
+        1.200000000e+01f, 1.200000000e+01f, 1.287500000e+01f, 1.375000000e+01f,
+        1.462500000e+01f, 1.550000000e+01f, 1.725000000e+01f, 1.900000000e+01f,
+        1.900000000e+01f, 1.900000000e+01f, 2.025000000e+01f, 2.150000000e+01f,
+        2.275000000e+01f, 2.400000000e+01f, 2.400000000e+01f, 2.400000000e+01f,
+        2.400000000e+01f,
     };
-
-    // Replicate each value 3 times
-    float scale[128];
-    int scale_len = 0;
-    for (int r = 0; r < 11; ++r) {
-        scale[scale_len++] = detune_ratios[r];
-        scale[scale_len++] = detune_ratios[r];
-        scale[scale_len++] = detune_ratios[r];
-    }
-    // scale_len = 33
-
-    // Pad to next power of 2 (64) by inserting midpoints at largest gaps
-    while (scale_len < 64) {
-        int gap = 0;
-        float max_diff = 0;
-        for (int i = 0; i < scale_len - 1; ++i) {
-            float d = scale[i + 1] - scale[i];
-            if (d > max_diff) {
-                max_diff = d;
-                gap = i;
-            }
-        }
-        float mid = (scale[gap] + scale[gap + 1]) / 2.0f;
-        for (int j = scale_len; j > gap + 1; --j) {
-            scale[j] = scale[j - 1];
-        }
-        scale[gap + 1] = mid;
-        scale_len++;
-    }
-
-    for (int i = 0; i < 64; ++i) {
-        out[i] = scale[i];
-    }
-    out[64] = scale[63];  // sentinel
+    memcpy(out, kDetuneQuantizer, sizeof(kDetuneQuantizer));
 }
 
 static void generateSvfShift(float* out) {
@@ -426,93 +492,243 @@ static void generatePitchRatioLow(float* out) {
     }
 }
 
+// ------------------------------------------------------------------
+// Rate-dependent tables
+// ------------------------------------------------------------------
+
+static void generateRateTables(RateTables& tables, uint32_t rate) {
+    float sampleRate = (float)rate;
+    generateApproxSvf(tables.svf_gain, tables.svf_g, tables.svf_r, tables.svf_h, sampleRate);
+    generateEnvIncrements(tables.env_increments, sampleRate);
+    generateMidiToFHigh(tables.midi_to_f_high, sampleRate);
+    generateMidiToIncrementHigh(tables.midi_to_inc_high, sampleRate);
+    tables.rate = rate;
+}
+
+void lutGeneratorSetSampleRate(uint32_t sampleRate) {
+    // Nothing to swap until the tables are laid out
+    if (sampleRate == s_activeRate || sampleRate == 0 || !s_rateTables[0].svf_gain) {
+        return;
+    }
+
+    // A cached rate is a pointer swap; any other rate regenerates the spare set
+    RateTables* tables = &s_rateTables[kNumCachedRates];
+    for (int i = 0; i < kNumCachedRates; ++i) {
+        if (kCachedRates[i] == sampleRate) {
+            tables = &s_rateTables[i];
+            break;
+        }
+    }
+    if (tables->rate != sampleRate) {
+        generateRateTables(*tables, sampleRate);
+    }
+
+    elements::lut_approx_svf_gain = tables->svf_gain;
+    elements::lut_approx_svf_g = tables->svf_g;
+    elements::lut_approx_svf_r = tables->svf_r;
+    elements::lut_approx_svf_h = tables->svf_h;
+    elements::lut_env_increments = tables->env_increments;
+    elements::lut_midi_to_f_high = tables->midi_to_f_high;
+    elements::lut_midi_to_increment_high = tables->midi_to_inc_high;
+    s_activeRate = sampleRate;
+    captureHotSources(true);
+}
+
 // ------------------------------------------------------------------
 // Main init function
 // ------------------------------------------------------------------
 
-void lutGeneratorInit(uint8_t* dram) {
+// Lays the tables out in the DRAM block and sets the global pointer
+// variables. With generate == false the block already holds the tables
+// (a LUT image read from the card).
+static void buildTables(uint8_t* dram, bool generate, uint32_t sampleRate) {
     uint8_t* cursor = dram;
 
     // Allocate and generate all float tables (elements namespace)
     float* sine = allocFloats(cursor, kSinSize);
-    generateSine(sine);
+    if (generate) {
+        generateSine(sine);
+    }
     elements::lut_sine = sine;
 
-    float* svf_gain = allocFloats(cursor, kSvfGainSize);
-    float* svf_g = allocFloats(cursor, kSvfGSize);
-    float* svf_r = allocFloats(cursor, kSvfRSize);
-    float* svf_h = allocFloats(cursor, kSvfHSize);
-    generateApproxSvf(svf_gain, svf_g, svf_r, svf_h);
-    elements::lut_approx_svf_gain = svf_gain;
-    elements::lut_approx_svf_g = svf_g;
-    elements::lut_approx_svf_r = svf_r;
-    elements::lut_approx_svf_h = svf_h;
+    // Rate-dependent tables: one set per cached rate plus the spare
+    for (int i = 0; i < kNumRateSets; ++i) {
+        RateTables& tables = s_rateTables[i];
+        tables.svf_gain = allocFloats(cursor, kSvfGainSize);
+        tables.svf_g = allocFloats(cursor, kSvfGSize);
+        tables.svf_r = allocFloats(cursor, kSvfRSize);
+        tables.svf_h = allocFloats(cursor, kSvfHSize);
+        tables.env_increments = allocFloats(cursor, kEnvIncrementsSize);
+        tables.midi_to_f_high = allocFloats(cursor, kMidiToFHighSize);
+        tables.midi_to_inc_high = allocFloats(cursor, kMidiToIncHighSize);
+        tables.rate = 0;
+        if (i < kNumCachedRates) {
+            if (generate) {
+                generateRateTables(tables, kCachedRates[i]);
+            }
+            tables.rate = kCachedRates[i];
+        }
+    }
+    s_activeRate = 0;
+    lutGeneratorSetSampleRate(sampleRate);
 
     float* four_decades = allocFloats(cursor, k4DecadesSize);
-    generate4Decades(four_decades);
+    if (generate) {
+        generate4Decades(four_decades);
+    }
     elements::lut_4_decades = four_decades;
 
     float* accent_coarse = allocFloats(cursor, kAccentCoarseSize);
     float* accent_fine = allocFloats(cursor, kAccentFineSize);
-    generateAccentGain(accent_coarse, accent_fine);
+    if (generate) {
+        generateAccentGain(accent_coarse, accent_fine);
+    }
     elements::lut_accent_gain_coarse = accent_coarse;
     elements::lut_accent_gain_fine = accent_fine;
 
     float* stiffness = allocFloats(cursor, kStiffnessSize);
-    generateStiffness(stiffness);
+    if (generate) {
+        generateStiffness(stiffness);
+    }
     elements::lut_stiffness = stiffness;
 
-    float* env_increments = allocFloats(cursor, kEnvIncrementsSize);
-    generateEnvIncrements(env_increments);
-    elements::lut_env_increments = env_increments;
-
     float* env_linear = allocFloats(cursor, kEnvLinearSize);
-    generateEnvLinear(env_linear);
+    if (generate) {
+        generateEnvLinear(env_linear);
+    }
     elements::lut_env_linear = env_linear;
 
     float* env_expo = allocFloats(cursor, kEnvExpoSize);
-    generateEnvExpo(env_expo);
+    if (generate) {
+        generateEnvExpo(env_expo);
+    }
     elements::lut_env_expo = env_expo;
 
     float* env_quartic = allocFloats(cursor, kEnvQuarticSize);
-    generateEnvQuartic(env_quartic);
+    if (generate) {
+        generateEnvQuartic(env_quartic);
+    }
     elements::lut_env_quartic = env_quartic;
 
-    float* midi_to_f_high = allocFloats(cursor, kMidiToFHighSize);
-    generateMidiToFHigh(midi_to_f_high);
-    elements::lut_midi_to_f_high = midi_to_f_high;
-
-    float* midi_to_inc_high = allocFloats(cursor, kMidiToIncHighSize);
-    generateMidiToIncrementHigh(midi_to_inc_high);
-    elements::lut_midi_to_increment_high = midi_to_inc_high;
-
     float* midi_to_f_low = allocFloats(cursor, kMidiToFLowSize);
-    generateMidiToFLow(midi_to_f_low);
+    if (generate) {
+        generateMidiToFLow(midi_to_f_low);
+    }
     elements::lut_midi_to_f_low = midi_to_f_low;
 
     float* fm_freq_quant = allocFloats(cursor, kFmFreqQuantSize);
-    generateFmFrequencyQuantizer(fm_freq_quant);
+    if (generate) {
+        generateFmFrequencyQuantizer(fm_freq_quant);
+    }
     elements::lut_fm_frequency_quantizer = fm_freq_quant;
 
     float* detune_quant = allocFloats(cursor, kDetuneQuantSize);
-    generateDetuneQuantizer(detune_quant);
+    if (generate) {
+        generateDetuneQuantizer(detune_quant);
+    }
     elements::lut_detune_quantizer = detune_quant;
 
     float* svf_shift = allocFloats(cursor, kSvfShiftSize);
-    generateSvfShift(svf_shift);
+    if (generate) {
+        generateSvfShift(svf_shift);
+    }
     elements::lut_svf_shift = svf_shift;
 
     // int16 table
     int16_t* db_led = allocInt16s(cursor, kDbLedSize);
-    generateDbLedBrightness(db_led);
+    if (generate) {
+        generateDbLedBrightness(db_led);
+    }
     elements::lut_db_led_brightness = db_led;
 
+#ifdef NT_ELEMENTS_MULAW_SAMPLES
+    int16_t* mulaw_decode = allocInt16s(cursor, kMulawDecodeSize);
+    if (generate) {
+        generateMulawDecode(mulaw_decode);
+    }
+    elements::lut_mulaw_decode = mulaw_decode;
+#endif
+
     // stmlib namespace tables
     float* pitch_ratio_high = allocFloats(cursor, kPitchRatioHighSize);
-    generatePitchRatioHigh(pitch_ratio_high);
+    if (generate) {
+        generatePitchRatioHigh(pitch_ratio_high);
+    }
     stmlib::lut_pitch_ratio_high = pitch_ratio_high;
 
     float* pitch_ratio_low = allocFloats(cursor, kPitchRatioLowSize);
-    generatePitchRatioLow(pitch_ratio_low);
+    if (generate) {
+        generatePitchRatioLow(pitch_ratio_low);
+    }
     stmlib::lut_pitch_ratio_low = pitch_ratio_low;
+
+    captureHotSources(false);
+}
+
+void lutGeneratorInit(uint8_t* dram, uint32_t sampleRate) {
+    buildTables(dram, true, sampleRate);
+}
+
+void lutGeneratorAdoptImage(uint8_t* dram, uint32_t sampleRate) {
+    buildTables(dram, false, sampleRate);
+}
+
+uint32_t lutImageChecksum(const uint8_t* data, size_t bytes) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < bytes; ++i) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+uint16_t lutImageFlags() {
+#ifdef NT_ELEMENTS_MULAW_SAMPLES
+    return kLutImageFlagMulaw;
+#else
+    return 0;
+#endif
+}
+
+size_t lutTierBytes(LutTier tier) {
+    if (tier == kLutTierDram) {
+        return lutGeneratorTotalBytes();
+    }
+    size_t bytes = 0;
+    for (int i = 0; i < kNumHotTables; ++i) {
+        if (s_hotTables[i].tier == tier) {
+            bytes += s_hotTables[i].size * sizeof(float);
+        }
+    }
+    return bytes;
+}
+
+void lutHotInit(LutHotCopies& copies, uint8_t* dtc) {
+    copies.dtc = dtc;
+    copies.generation = s_generation - 1;
+}
+
+void lutHotBind(LutHotCopies& copies) {
+    // Nothing to copy until the DRAM block is laid out
+    if (!s_hotTables[0].dram) {
+        return;
+    }
+
+    const bool stale = copies.generation != s_generation;
+    uint8_t* cursor[kNumLutTiers] = { copies.dtc, nullptr };
+    for (int i = 0; i < kNumHotTables; ++i) {
+        HotTable& table = s_hotTables[i];
+        if (!cursor[table.tier]) {
+            // No memory granted in this tier: read the master
+            *table.global = table.dram;
+            continue;
+        }
+        float* copy = allocFloats(cursor[table.tier], table.size);
+        if (stale) {
+            memcpy(copy, table.dram, table.size * sizeof(float));
+        }
+        *table.global = copy;
+    }
+    copies.generation = s_generation;
 }
@@ -18,6 +18,69 @@
 size_t lutGeneratorTotalBytes();
 
 // Computes all LUTs into the DRAM block and sets the global pointer variables
-void lutGeneratorInit(uint8_t* dram);
+// for the given sample rate. Rate-dependent tables are kept for 32/48/96kHz.
+void lutGeneratorInit(uint8_t* dram, uint32_t sampleRate);
+
+// Sets the global pointer variables for tables already in the DRAM block
+// (a LUT image read from the card, see lut_loader.h). Same layout as
+// lutGeneratorInit(); nothing is computed.
+void lutGeneratorAdoptImage(uint8_t* dram, uint32_t sampleRate);
+
+// Points the rate-dependent LUTs (SVF, envelope increments, MIDI to
+// frequency) at the tables for sampleRate. Cached rates are a pointer swap;
+// any other rate regenerates one spare set. Cheap when the rate is unchanged.
+void lutGeneratorSetSampleRate(uint32_t sampleRate);
+
+// Hot-table placement
+// The tables read on every block of the resonator path are copied from the
+// shared DRAM block into faster per-instance memory (see s_hotTables in
+// lut_generator.cpp); the rest are read from DRAM.
+enum LutTier {
+    kLutTierDtc,
+    kLutTierDram,
+    kNumLutTiers
+};
+
+// One instance's copies of the hot tables
+struct LutHotCopies {
+    uint8_t* dtc;
+    uint32_t generation;    // Table generation the copies were made from
+};
+
+// Bytes of hot tables placed in a tier (per instance). kLutTierDram
+// returns the shared block, which keeps the masters of every table.
+size_t lutTierBytes(LutTier tier);
+
+// Sets the region (lutTierBytes(kLutTierDtc), 4-byte aligned) an instance
+// copies its hot tables into. A null region leaves them in DRAM.
+void lutHotInit(LutHotCopies& copies, uint8_t* dtc);
+
+// Points the hot-table globals at this instance's copies, refreshing them
+// first if the tables or the active rate changed since the last call. Call
+// after lutGeneratorSetSampleRate() and before the DSP reads any table.
+void lutHotBind(LutHotCopies& copies);
+
+// Precomputed LUT image (luts.wav, written by tools/lut_image.cpp)
+// The file is a mono 16-bit WAV whose frames hold a LutImageHeader followed
+// by the lutGeneratorTotalBytes() DRAM block exactly as lutGeneratorInit()
+// lays it out. Bump kLutImageVersion whenever a formula or the layout changes.
+static const uint32_t kLutImageMagic = 0x54554C45;     // "ELUT" little-endian
+static const uint16_t kLutImageVersion = 2;
+static const uint16_t kLutImageFlagMulaw = 1 << 0;     // Includes lut_mulaw_decode
+
+struct LutImageHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t flags;         // lutImageFlags() of the build that wrote it
+    uint32_t imageBytes;    // lutGeneratorTotalBytes() of that build
+    uint32_t checksum;      // lutImageChecksum() of the image bytes
+    uint32_t reserved[4];
+};
+
+// Checksum over the image bytes (FNV-1a)
+uint32_t lutImageChecksum(const uint8_t* data, size_t bytes);
+
+// Layout flags of this build
+uint16_t lutImageFlags();
 
 #endif // NT_ELEMENTS_LUT_GENERATOR_H_
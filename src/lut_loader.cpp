@@ -0,0 +1,177 @@
+// Copyright 2025 Neal Sanche
+// SPDX-License-Identifier: MIT
+
+#include "lut_loader.h"
+#include "lut_generator.h"
+#include <distingnt/api.h>
+#include <string.h>
+
+static_assert(sizeof(LutImageHeader) == LutLoader::kHeaderBytes, "LUT image header size");
+
+size_t LutLoader::blockBytes() {
+    return kHeaderBytes + lutGeneratorTotalBytes() + kChunkBytes;
+}
+
+void LutLoader::begin(uint8_t* block, uint32_t sampleRate) {
+    block_ = block;
+    chunk_ = block + kHeaderBytes + lutGeneratorTotalBytes();
+    callbackPending_ = false;
+    callbackSuccess_ = false;
+    offset_ = 0;
+    waitFrames_ = 0;
+    ready_ = false;
+    fromImage_ = false;
+    memset(&request_, 0, sizeof(request_));
+
+    uint32_t folder = 0;
+    uint32_t sample = 0;
+    if (findImage(folder, sample)) {
+        // Tables read as zero until the image lands; the pointers are set
+        // now, so nothing dereferences an unset table in the meantime
+        memset(block_, 0, kHeaderBytes + lutGeneratorTotalBytes());
+        lutGeneratorAdoptImage(block_ + kHeaderBytes, sampleRate);
+
+        request_.folder = folder;
+        request_.sample = sample;
+        request_.channels = kNT_WavMono;
+        request_.bits = kNT_WavBits16;
+        request_.progress = kNT_WavNoProgress;
+        request_.callback = &LutLoader::onImageLoaded;
+        request_.callbackData = this;
+        if (readChunk()) {
+            return;
+        }
+    }
+
+    // No image: compute the tables now, as before
+    generate(sampleRate);
+}
+
+bool LutLoader::poll(uint32_t sampleRate, int numFrames) {
+    if (ready_) {
+        return true;
+    }
+    if (callbackPending_) {
+        waitFrames_ += static_cast<uint32_t>(numFrames);
+        if (waitFrames_ < sampleRate / 1000 * kTimeoutMs) {
+            return false;
+        }
+        // The callback is lost or the card stalled. The read can still
+        // complete, but only into chunk_, which nothing reads from now on
+        generate(sampleRate);
+        return true;
+    }
+    if (!callbackSuccess_) {
+        generate(sampleRate);
+        return true;
+    }
+
+    const size_t imageBytes = kHeaderBytes + lutGeneratorTotalBytes();
+    const size_t bytes = imageBytes - offset_ < kChunkBytes ? imageBytes - offset_ : kChunkBytes;
+    memcpy(block_ + offset_, chunk_, bytes);
+    offset_ += bytes;
+
+    // A stale image is recognised from its header; don't read the rest
+    if (offset_ == bytes && !headerValid()) {
+        generate(sampleRate);
+        return true;
+    }
+    if (offset_ < imageBytes) {
+        if (readChunk()) {
+            return false;
+        }
+        generate(sampleRate);
+        return true;
+    }
+
+    if (imageValid()) {
+        lutGeneratorAdoptImage(block_ + kHeaderBytes, sampleRate);
+        fromImage_ = true;
+        ready_ = true;
+    } else {
+        // Corrupt image: generate (once, before any audio)
+        generate(sampleRate);
+    }
+    return true;
+}
+
+bool LutLoader::readChunk() {
+    const size_t imageBytes = kHeaderBytes + lutGeneratorTotalBytes();
+    const size_t bytes = imageBytes - offset_ < kChunkBytes ? imageBytes - offset_ : kChunkBytes;
+
+    request_.dst = chunk_;
+    request_.numFrames = static_cast<uint32_t>(bytes / 2);
+    request_.startOffset = static_cast<uint32_t>(offset_ / 2);
+
+    waitFrames_ = 0;
+    callbackSuccess_ = false;
+    callbackPending_ = true;
+    if (NT_readSampleFrames(request_)) {
+        return true;
+    }
+    callbackPending_ = false;
+    return false;
+}
+
+void LutLoader::generate(uint32_t sampleRate) {
+    lutGeneratorInit(block_ + kHeaderBytes, sampleRate);
+    ready_ = true;
+}
+
+bool LutLoader::findImage(uint32_t& folder, uint32_t& sample) const {
+    if (!NT_isSdCardMounted()) {
+        return false;
+    }
+
+    const uint32_t numFolders = NT_getNumSampleFolders();
+    for (uint32_t i = 0; i < numFolders; i++) {
+        _NT_wavFolderInfo folderInfo;
+        NT_getSampleFolderInfo(i, folderInfo);
+        if (!folderInfo.name || strcmp(folderInfo.name, kFolderName) != 0) {
+            continue;
+        }
+
+        for (uint32_t j = 0; j < folderInfo.numSampleFiles; j++) {
+            _NT_wavInfo fileInfo;
+            NT_getSampleFileInfo(i, j, fileInfo);
+            if (!fileInfo.name || strcmp(fileInfo.name, kFileName) != 0) {
+                continue;
+            }
+            // An image for another build has another size
+            if (fileInfo.channels != kNT_WavMono || fileInfo.bits != kNT_WavBits16 ||
+                fileInfo.numFrames * 2 != kHeaderBytes + lutGeneratorTotalBytes()) {
+                return false;
+            }
+            folder = i;
+            sample = j;
+            return true;
+        }
+        return false;
+    }
+
+    return false;
+}
+
+bool LutLoader::headerValid() const {
+    LutImageHeader header;
+    memcpy(&header, block_, sizeof(header));
+
+    return header.magic == kLutImageMagic &&
+        header.version == kLutImageVersion &&
+        header.flags == lutImageFlags() &&
+        header.imageBytes == lutGeneratorTotalBytes();
+}
+
+bool LutLoader::imageValid() const {
+    LutImageHeader header;
+    memcpy(&header, block_, sizeof(header));
+
+    return headerValid() &&
+        header.checksum == lutImageChecksum(block_ + kHeaderBytes, lutGeneratorTotalBytes());
+}
+
+void LutLoader::onImageLoaded(void* userData, bool success) {
+    LutLoader* self = static_cast<LutLoader*>(userData);
+    self->callbackSuccess_ = success;
+    self->callbackPending_ = false;
+}
@@ -0,0 +1,103 @@
+// Copyright 2025 Neal Sanche
+// SPDX-License-Identifier: MIT
+
+#ifndef LUT_LOADER_H
+#define LUT_LOADER_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <distingnt/wav.h>
+
+/**
+ * LutLoader - Fills the LUT block from a precomputed image on the SD card
+ *
+ * lutGeneratorInit() computes every table at plugin load with thousands of
+ * sinf/powf/tanf/expf calls. When the sample folder holds a luts.wav written
+ * by tools/lut_image.cpp (make lut-image), initialise() reads it straight
+ * into the static DRAM block instead. The image carries a version, the
+ * layout flags and size of the build that wrote it, and a checksum; any
+ * mismatch falls back to runtime generation.
+ *
+ * The card is read asynchronously, so the tables are not ready when
+ * initialise() returns. The block is zeroed first (construct() may read it)
+ * and step() skips the DSP and sample loading until poll() returns true.
+ * The image is read a chunk at a time into a scratch buffer after the
+ * tables and copied into place by poll(), so a read that is given up on can
+ * only land in the scratch buffer, never in tables the DSP is using.
+ *
+ * Usage:
+ *   1. Reserve blockBytes() of static DRAM
+ *   2. Call begin() in initialise(); it generates the tables itself when
+ *      there is no usable image on the card
+ *   3. Call poll() at the top of step() and return early while it is false
+ */
+class LutLoader {
+public:
+    static constexpr const char* kFolderName = "elements";
+    static constexpr const char* kFileName = "luts.wav";
+    static constexpr size_t kHeaderBytes = 32;      // sizeof(LutImageHeader)
+
+    static constexpr size_t kChunkBytes = 4096;     // Image bytes per read
+    static constexpr uint32_t kTimeoutMs = 250;     // Wait for one chunk before generating
+
+    /**
+     * @return Static DRAM needed: header, tables and the chunk buffer
+     */
+    static size_t blockBytes();
+
+    /**
+     * Start filling the LUT block.
+     *
+     * @param block Static DRAM of blockBytes(): kHeaderBytes of header, the
+     *              tables, then the chunk buffer
+     * @param sampleRate Rate the rate-dependent tables are picked for
+     */
+    void begin(uint8_t* block, uint32_t sampleRate);
+
+    /**
+     * Copy in a finished chunk and request the next one. Adopts the image
+     * once it is complete and checks out; generates the tables if it
+     * doesn't, or if a chunk takes longer than kTimeoutMs. Cheap once ready.
+     *
+     * @param sampleRate Rate the rate-dependent tables are picked for
+     * @param numFrames Frames in this step(), to time the pending read
+     * @return true when the tables are usable
+     */
+    bool poll(uint32_t sampleRate, int numFrames);
+
+    /**
+     * @return true if the tables came from the card image
+     */
+    bool fromImage() const { return fromImage_; }
+
+private:
+    // Find luts.wav; returns false if absent or the wrong size
+    bool findImage(uint32_t& folder, uint32_t& sample) const;
+
+    // Request the chunk at offset_ into the chunk buffer
+    bool readChunk();
+
+    // Check the header of the image (readable after the first chunk)
+    bool headerValid() const;
+
+    // Check the header and checksum of the image that was read
+    bool imageValid() const;
+
+    // Give up on the image and compute the tables
+    void generate(uint32_t sampleRate);
+
+    // Callback for async WAV loading
+    static void onImageLoaded(void* userData, bool success);
+
+    uint8_t* block_;
+    uint8_t* chunk_;                // Read target; only poll() copies it into block_
+    _NT_wavRequest request_;        // Must persist until the callback
+    volatile bool callbackPending_;
+    volatile bool callbackSuccess_;
+    size_t offset_;                 // Image bytes copied into block_
+    uint32_t waitFrames_;           // Frames the pending chunk has taken
+    bool ready_;
+    bool fromImage_;
+};
+
+#endif // LUT_LOADER_H
@@ -0,0 +1,62 @@
+// Copyright 2025 Neal Sanche
+// SPDX-License-Identifier: MIT
+
+#include "mod_matrix.h"
+
+void ModMatrix::init() {
+    numRoutes_ = 0;
+    numSources_ = 0;
+    destinations_ = 0;
+}
+
+void ModMatrix::configure(const int16_t* v) {
+    init();
+
+    for (int slot = 0; slot < kNumSlots; ++slot) {
+        const int base = kParamModSource1 + slot * kModSlotParams;
+        const int bus = v[base] - 1;
+        const int destination = v[base + 1];
+        const int depth = v[base + 2];
+        if (bus < 0 || bus >= kNumBuses || depth == 0 ||
+            destination < 0 || destination >= kNumPatchMappings) {
+            continue;
+        }
+
+        // Slots sharing a bus share its source entry
+        int source = 0;
+        while (source < numSources_ && sources_[source] != bus) {
+            ++source;
+        }
+        if (source == numSources_) {
+            sources_[numSources_++] = static_cast<uint8_t>(bus);
+        }
+
+        Route& route = routes_[numRoutes_++];
+        route.source = static_cast<uint8_t>(source);
+        route.destination = static_cast<uint8_t>(destination);
+        route.depth = static_cast<float>(depth) * 0.01f;
+        destinations_ |= 1u << destination;
+    }
+}
+
+uint32_t ModMatrix::process(const float* busFrames, int numFrames, int frame,
+                            float* offsets) const {
+    if (numRoutes_ == 0) {
+        return 0;
+    }
+
+    // CV range: -5V to +5V is -1 to +1
+    float cv[kNumSlots];
+    for (int i = 0; i < numSources_; ++i) {
+        const float volts = busFrames[sources_[i] * numFrames + frame];
+        cv[i] = volts < -5.0f ? -1.0f : (volts > 5.0f ? 1.0f : volts * 0.2f);
+    }
+
+    for (uint32_t mask = destinations_; mask; mask &= mask - 1) {
+        offsets[__builtin_ctz(mask)] = 0.0f;
+    }
+    for (int i = 0; i < numRoutes_; ++i) {
+        offsets[routes_[i].destination] += cv[routes_[i].source] * routes_[i].depth;
+    }
+    return destinations_;
+}
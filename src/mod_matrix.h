@@ -0,0 +1,80 @@
+// Copyright 2025 Neal Sanche
+// SPDX-License-Identifier: MIT
+
+#ifndef MOD_MATRIX_H
+#define MOD_MATRIX_H
+
+#include <stdint.h>
+
+#include "patch_mapping.h"
+
+/**
+ * ModMatrix - Routes CV buses to Patch fields with a per-slot depth
+ *
+ * Each of the kNumSlots slots has three parameters: a source CV bus
+ * (0 = none), a destination (an index into kPatchMappings) and a depth
+ * (-100% to +100%). A +5V source at 100% depth sweeps the destination over
+ * its whole range; slots on the same destination add up.
+ *
+ * configure() compacts the assigned slots into a route list and the buses
+ * they read into a source list, so process() costs nothing for unassigned
+ * slots and reads each bus once however many slots share it. process()
+ * only produces offsets; step() adds them to the pot values and clamps
+ * each field once (see the Patch pass in nt_elements.cpp).
+ *
+ * Usage:
+ *   1. Call init() in construct()
+ *   2. Call configure() from step() after any slot parameter changed
+ *   3. Call process() once per Elements block and add offsets[i] to the
+ *      fields whose bit is set in the returned mask
+ */
+class ModMatrix {
+public:
+    static constexpr int kNumSlots = 8;
+    static constexpr int kNumBuses = 28;
+
+    /**
+     * Clear all routes.
+     */
+    void init();
+
+    /**
+     * Rebuild the route and source lists from the slot parameters.
+     *
+     * @param v NT parameter values (kParamModSource1 onwards)
+     */
+    void configure(const int16_t* v);
+
+    /**
+     * Read the source buses at one frame and accumulate the routed offsets.
+     *
+     * @param busFrames NT bus buffers
+     * @param numFrames Frames per bus in busFrames
+     * @param frame Frame to read the sources at
+     * @param offsets Per-mapping offsets, in units of the mapping's range;
+     *                only the entries in the returned mask are written
+     * @return Mask of the mappings that received an offset
+     */
+    uint32_t process(const float* busFrames, int numFrames, int frame,
+                     float* offsets) const;
+
+    /**
+     * Get the mask of the mappings with at least one route.
+     */
+    uint32_t destinations() const { return destinations_; }
+
+private:
+    struct Route {
+        uint8_t source;       // Index into sources_
+        uint8_t destination;  // Index into kPatchMappings
+        float depth;          // -1.0 to 1.0
+    };
+
+    Route routes_[kNumSlots];
+    uint8_t sources_[kNumSlots];  // 0-based bus of each distinct source
+    int numRoutes_;
+    int numSources_;
+    uint32_t destinations_;
+};
+
+#endif // MOD_MATRIX_H
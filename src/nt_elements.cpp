@@ -37,13 +37,43 @@
 #include "oled_display.h"
 #include "sample_manager.h"
 #include "lut_generator.h"
+#include "lut_loader.h"
+#include "patch_mapping.h"
+#include "cpu_governor.h"
 
 // Global pointers for Elements sample data (declared in elements/resources.h via patch)
 // These are set after SampleManager loads samples from SD card
 namespace elements {
-const int16_t* smp_sample_data_ptr = nullptr;
-const int16_t* smp_noise_sample_ptr = nullptr;
+const SampleStorage* smp_sample_data_ptr = nullptr;
+const SampleStorage* smp_noise_sample_ptr = nullptr;
 const size_t* smp_boundaries_ptr = nullptr;
+const SampleStorage* const* smp_wavetable_data_ptr = nullptr;
+const size_t* smp_wavetable_size_ptr = nullptr;
+
+#ifndef NT_ELEMENTS_FIXED_SAMPLE_RATE
+// Host sample rate read by kSampleRate (declared in elements/dsp/dsp.h via
+// patch), cached once per block by updateSampleRate()
+float g_sample_rate = 32000.0f;
+#endif
+}
+
+// Cache NT_globals.sampleRate for the DSP. Builds with
+// NT_ELEMENTS_FIXED_SAMPLE_RATE use a literal rate instead.
+static inline void updateSampleRate() {
+#ifndef NT_ELEMENTS_FIXED_SAMPLE_RATE
+    elements::g_sample_rate = static_cast<float>(NT_globals.sampleRate);
+#endif
+}
+
+// Rate the DSP runs at, and so the rate the LUTs are generated and bound for.
+// A fixed-rate build has its constants folded for one rate and never follows
+// the host.
+static inline uint32_t dspSampleRate() {
+#ifdef NT_ELEMENTS_FIXED_SAMPLE_RATE
+    return NT_ELEMENTS_FIXED_SAMPLE_RATE;
+#else
+    return NT_globals.sampleRate;
+#endif
 }
 
 // Factory functions forward declarations
@@ -58,10 +88,24 @@ static void midiMessage(_NT_algorithm* self, uint8_t b0, uint8_t b1, uint8_t b2)
 static uint32_t hasCustomUi(_NT_algorithm* self);
 static void customUi(_NT_algorithm* self, const _NT_uiData& data);
 static void setupUi(_NT_algorithm* self, _NT_float3& pots);
+static void serialise(_NT_algorithm* self, _NT_jsonStream& stream);
+static bool deserialise(_NT_algorithm* self, _NT_jsonParse& parse);
 
 // Easter Egg enum strings
 static const char* const easterEggStrings[] = { "Off", "On", nullptr };
 
+// Sample Bank enum strings (folder "elements", then "elements_user1".."elements_user3")
+static const char* const sampleBankStrings[] = { "Factory", "User 1", "User 2", "User 3", nullptr };
+
+// Morph Mode enum strings (see MorphMode)
+static const char* const morphModeStrings[] = { "Off", "Edit A", "Edit B", "Morph", nullptr };
+
+// Modulation matrix slot: source CV bus, destination (Patch mapping), depth
+#define MOD_SLOT_PARAMETERS(n, dest) \
+    NT_PARAMETER_CV_INPUT("Mod " #n " Src", 0, 0) \
+    { .name = "Mod " #n " Dest", .min = 0, .max = kNumPatchMappings - 1, .def = patchMappingIndex(dest), .unit = kNT_unitEnum, .scaling = kNT_scalingNone, .enumStrings = kPatchMappingNames }, \
+    { .name = "Mod " #n " Depth", .min = -100, .max = 100, .def = 0, .unit = kNT_unitPercent, .scaling = 0, .enumStrings = NULL },
+
 // Parameter definitions
 static const _NT_parameter parameters[kNumParams] = {
     // System parameters - Dual external inputs for Elements
@@ -116,6 +160,27 @@ static const _NT_parameter parameters[kNumParams] = {
 
     // Easter Egg (OminousVoice FM synthesis mode)
     { .name = "Easter Egg", .min = 0, .max = 1, .def = 0, .unit = kNT_unitEnum, .scaling = kNT_scalingNone, .enumStrings = easterEggStrings },
+
+    // Engine - CPU governor (100% = unlimited, lower values shed resonator modes)
+    { .name = "CPU Budget", .min = 10, .max = 100, .def = 100, .unit = kNT_unitPercent, .scaling = 0, .enumStrings = NULL },
+
+    // Engine - sample bank (swapped in once loaded, shared by all instances)
+    { .name = "Sample Bank", .min = 0, .max = 3, .def = 0, .unit = kNT_unitEnum, .scaling = kNT_scalingNone, .enumStrings = sampleBankStrings },
+
+    // Modulation matrix (any CV bus onto any Patch field, see mod_matrix.h)
+    MOD_SLOT_PARAMETERS(1, kParamGeometry)
+    MOD_SLOT_PARAMETERS(2, kParamDamping)
+    MOD_SLOT_PARAMETERS(3, kParamResonatorPosition)
+    MOD_SLOT_PARAMETERS(4, kParamBrightness)
+    MOD_SLOT_PARAMETERS(5, kParamBowTimbre)
+    MOD_SLOT_PARAMETERS(6, kParamStrikeMallet)
+    MOD_SLOT_PARAMETERS(7, kParamInharmonicity)
+    MOD_SLOT_PARAMETERS(8, kParamReverbAmount)
+
+    // Patch morphing (Edit A/B store the pots into a snapshot, Morph blends them)
+    { .name = "Morph Mode", .min = 0, .max = 3, .def = 0, .unit = kNT_unitEnum, .scaling = kNT_scalingNone, .enumStrings = morphModeStrings },
+    { .name = "Morph", .min = 0, .max = 100, .def = 0, .unit = kNT_unitPercent, .scaling = 0, .enumStrings = NULL },
+    NT_PARAMETER_CV_INPUT("Morph CV", 0, 0)
 };
 
 // Parameter pages for menu organization
@@ -132,7 +197,8 @@ static const uint8_t pageSpace[] = {
 };
 
 static const uint8_t pagePerformance[] = {
-    kParamCoarseTune, kParamFineTune, kParamOutputLevel, kParamFMAmount, kParamExciterContour, kParamStrength
+    kParamCoarseTune, kParamFineTune, kParamOutputLevel, kParamFMAmount, kParamExciterContour, kParamStrength,
+    kParamCpuBudget, kParamSampleBank
 };
 
 static const uint8_t pageRouting[] = {
@@ -143,12 +209,29 @@ static const uint8_t pageRouting[] = {
     kParamEasterEgg
 };
 
+static const uint8_t pageModMatrix[] = {
+    kParamModSource1, kParamModDest1, kParamModDepth1,
+    kParamModSource2, kParamModDest2, kParamModDepth2,
+    kParamModSource3, kParamModDest3, kParamModDepth3,
+    kParamModSource4, kParamModDest4, kParamModDepth4,
+    kParamModSource5, kParamModDest5, kParamModDepth5,
+    kParamModSource6, kParamModDest6, kParamModDepth6,
+    kParamModSource7, kParamModDest7, kParamModDepth7,
+    kParamModSource8, kParamModDest8, kParamModDepth8
+};
+
+static const uint8_t pageMorph[] = {
+    kParamMorphMode, kParamMorph, kParamMorphCV
+};
+
 static const _NT_parameterPage pages[] = {
     { .name = "Exciter", .numParams = sizeof(pageExciter), .group = 0, .unused = {}, .params = pageExciter },
     { .name = "Resonator", .numParams = sizeof(pageResonator), .group = 0, .unused = {}, .params = pageResonator },
     { .name = "Space", .numParams = sizeof(pageSpace), .group = 0, .unused = {}, .params = pageSpace },
     { .name = "Performance", .numParams = sizeof(pagePerformance), .group = 0, .unused = {}, .params = pagePerformance },
     { .name = "Routing", .numParams = sizeof(pageRouting), .group = 0, .unused = {}, .params = pageRouting },
+    { .name = "Mod Matrix", .numParams = sizeof(pageModMatrix), .group = 0, .unused = {}, .params = pageModMatrix },
+    { .name = "Morph", .numParams = sizeof(pageMorph), .group = 0, .unused = {}, .params = pageMorph },
 };
 
 static const _NT_parameterPages parameterPages = {
@@ -175,36 +258,96 @@ static const _NT_factory factory = {
     .tags = kNT_tagInstrument,
     .hasCustomUi = hasCustomUi,
     .customUi = customUi,
-    .setupUi = setupUi
+    .setupUi = setupUi,
+    .serialise = serialise,
+    .deserialise = deserialise
 };
 
+// DTC offset of the hot LUT copies (after the Part, 8-byte aligned). The
+// Patch lives inside the Part, so it needs no room of its own.
+static const size_t kLutDtcOffset =
+    (sizeof(elements::Part) + 7) & ~static_cast<size_t>(7);
+
+// DRAM offset of the cold Part state (after reverb buffer, 8-byte aligned)
+static const size_t kColdStateDramOffset =
+    ((32768 * sizeof(uint16_t)) + 7) & ~static_cast<size_t>(7);
+
+// Static DRAM layout (shared by all instances):
+// [SampleManager] [wavetable pool + noise + silent page (two sets, ~432KB, ~216KB with mu-law storage, ~836KB resampled)] [LUT image header] [LUTs]
+static const size_t kSampleDataStaticOffset =
+    (sizeof(SampleManager) + 7) & ~static_cast<size_t>(7);
+static const size_t kLutStaticOffset =
+    (kSampleDataStaticOffset + SampleManager::kTotalDramBytes + 7) & ~static_cast<size_t>(7);
+
+// Shared sample manager, constructed in initialise()
+static SampleManager* s_sampleManager = nullptr;
+
+// Fills the LUTs from luts.wav on the card, or generates them
+static LutLoader s_lutLoader;
+
+// Firmware runs the DWT cycle counter the CPU governor reads (initialise())
+static bool s_cycleCounterRunning = false;
+
+// An instance or a preset has chosen the plugin-wide Sample Bank
+static bool s_sampleBankChosen = false;
+
 // Factory implementations
 
 static void calculateStaticRequirements(_NT_staticRequirements& req) {
-    req.dram = lutGeneratorTotalBytes();
+    req.dram = kLutStaticOffset + LutLoader::blockBytes();
 }
 
 static void initialise(_NT_staticMemoryPtrs& ptrs, const _NT_staticRequirements& /*req*/) {
-    lutGeneratorInit(ptrs.dram);
+    updateSampleRate();
+
+    // The CPU governor times blocks with the DWT cycle counter; it is the
+    // firmware's, so if firmware left it off the CPU Budget has no effect
+    s_cycleCounterRunning = CpuGovernor::cycleCounterRunning();
+#ifdef NT_EMU_DEBUG
+    printf("Cycle counter %s: CPU Budget %s\n", s_cycleCounterRunning ? "running" : "unavailable",
+           s_cycleCounterRunning ? "active" : "has no effect");
+#endif
+
+    // Sample data is loaded once and shared by every instance
+    s_sampleManager = new (ptrs.dram) SampleManager();
+    s_sampleManager->init(reinterpret_cast<SampleManager::Sample*>(ptrs.dram + kSampleDataStaticOffset));
+
+    // The exciter reads wavetables through the manager's per-wavetable tables,
+    // which point at the silent page until each wavetable is loaded in step()
+    elements::smp_sample_data_ptr = s_sampleManager->getSampleData();
+    elements::smp_noise_sample_ptr = s_sampleManager->getNoiseSample();
+    elements::smp_boundaries_ptr = s_sampleManager->getBoundaries();
+    elements::smp_wavetable_data_ptr = s_sampleManager->getWavetableData();
+    elements::smp_wavetable_size_ptr = s_sampleManager->getWavetableSizes();
+
+    // Reads the precomputed image if the card has one (finished in step()),
+    // otherwise generates the tables here
+    s_lutLoader.begin(ptrs.dram + kLutStaticOffset, dspSampleRate());
 }
 
 static void calculateRequirements(_NT_algorithmRequirements& req, const int32_t* /*specifications*/) {
     req.numParameters = kNumParams;
 
-    // DTC: Elements Part instance (~4KB for hot state)
-    req.dtc = sizeof(elements::Part) + sizeof(elements::Patch);
+    // DTC: Elements Part hot state only (SVF states, envelope, exciter state).
+    // The OminousVoice and string model delay lines are split out into
+    // PartColdState in DRAM (see elements-part-cold-state.patch).
+    // The LUTs read on every block follow it (see s_hotTables in lut_generator.cpp).
+    req.dtc = kLutDtcOffset + lutTierBytes(kLutTierDtc);
 
     // SRAM: Temp buffers for audio processing (4 * 512 floats = 8KB)
     req.sram = sizeof(nt_elementsAlgorithm) + (4 * 512 * sizeof(float));
 
-    // DRAM: Reverb buffer (32768 samples = 64KB for uint16_t) + Sample data (~338KB)
-    // Layout: [reverb_buffer (64KB)] [sample_data (~338KB)]
-    req.dram = (32768 * sizeof(uint16_t)) + SampleManager::kTotalDramBytes;
+    // DRAM: Reverb buffer (32768 samples = 64KB for uint16_t) + cold Part state
+    // Layout: [reverb_buffer (64KB)] [PartColdState]
+    // Sample data is shared by all instances in static DRAM (see initialise())
+    req.dram = kColdStateDramOffset + sizeof(elements::PartColdState);
 
-    req.itc = 0;
+    // ITC: Per-sample step() kernel and resonator filter loops (see
+    // itc_code.h). Zero on the desktop build.
+    req.itc = itcCodeBytes();
 }
 
-static _NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_algorithmRequirements& /*req*/, const int32_t* /*specifications*/) {
+static _NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_algorithmRequirements& req, const int32_t* /*specifications*/) {
     // Use placement new to properly construct algorithm instance in SRAM
     nt_elementsAlgorithm* self = new (ptrs.sram) nt_elementsAlgorithm();
 
@@ -235,30 +378,51 @@ static _NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_a
     // Allocate reverb buffer from DRAM (first 64KB)
     self->reverb_buffer = reinterpret_cast<uint16_t*>(ptrs.dram);
 
-    // Initialize sample manager with remaining DRAM (after reverb buffer)
-    // DRAM layout: [reverb_buffer (64KB)] [sample_data (~338KB)]
-    uint8_t* sample_dram = reinterpret_cast<uint8_t*>(ptrs.dram) + (32768 * sizeof(uint16_t));
-    self->sample_manager.init(reinterpret_cast<int16_t*>(sample_dram));
-    self->sd_card_was_mounted = false;
+    // Samples are shared: the first instance to step() loads them, the rest reuse them
+    self->sample_manager = s_sampleManager;
+    self->sample_bank_live = false;
 
-    // Initialize global sample pointers to point to zero-filled buffers
-    // These will be updated to real samples when loading completes in step()
-    elements::smp_sample_data_ptr = self->sample_manager.getSampleData();
-    elements::smp_noise_sample_ptr = self->sample_manager.getNoiseSample();
-    elements::smp_boundaries_ptr = self->sample_manager.getBoundaries();
+    // Construct the cold Part state in DRAM, then the hot Part in DTC
+    elements::PartColdState* cold_state = new (reinterpret_cast<uint8_t*>(ptrs.dram) + kColdStateDramOffset)
+        elements::PartColdState();
+    self->elements_part = new (ptrs.dtc) elements::Part(cold_state);
 
-    // Use placement new to construct Elements Part in DTC
-    self->elements_part = new (ptrs.dtc) elements::Part();
+#ifdef NT_EMU_DEBUG
+    printf("Part layout: DTC %u bytes, cold state %u bytes in DRAM (DTC saved)\n",
+           static_cast<unsigned>(sizeof(elements::Part)),
+           static_cast<unsigned>(sizeof(elements::PartColdState)));
+#endif
 
-    // Initialize Elements Part with reverb buffer
+    // Hot LUT copies; bound here as well as in step() because Init() may read
+    // them, and the last instance to bind may since have been destroyed
+    lutHotInit(self->lut_copies, reinterpret_cast<uint8_t*>(ptrs.dtc) + kLutDtcOffset);
+    lutHotBind(self->lut_copies);
+#ifdef NT_EMU_DEBUG
+    printf("LUT placement: DTC %u bytes per instance, DRAM %u bytes shared\n",
+           static_cast<unsigned>(lutTierBytes(kLutTierDtc)),
+           static_cast<unsigned>(lutTierBytes(kLutTierDram)));
+#endif
+
+    // Initialize Elements Part with reverb buffer (Init reads kSampleRate)
+    updateSampleRate();
     self->elements_part->Init(self->reverb_buffer);
 
+    // Start with all resonator modes active (governor disabled at 100% budget)
+    self->cpu_governor.init();
+
     // Initialize base strength (default = 80%) - must be before perf_state init
     self->base_strength = 0.8f;
 
     // Initialize FM amount (default = 0, no modulation)
     self->fm_amount = 0.0f;
 
+    // The first step() writes every mapped Patch field from the parameters
+    self->patch_dirty = kAllPatchMappings;
+    self->patch_modulated = 0;
+    self->mod_matrix.init();
+    self->mod_matrix_dirty = true;
+    self->patch_smoother.init(*self->elements_part->mutable_patch());
+
     // Initialize default performance state (gate ON by default to trigger bow exciter)
     self->perf_state.gate = true;   // Enable gate so bow exciter produces sound on startup
     self->perf_state.note = 69.0f;  // MIDI note number A4 (69)
@@ -297,6 +461,18 @@ static _NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_a
     memset(self->output_aux, 0, sizeof(self->output_aux));
     self->buffer_pos = 0;
 
+    // Copy the step() kernel and the resonator filter loops into ITC (they
+    // run in place if no ITC was granted). After Part::Init(), which points
+    // the resonator at the original Render().
+    ItcKernels itc_kernels;
+    itcCodeInstall(reinterpret_cast<uint8_t*>(ptrs.itc), req.itc, &itc_kernels);
+    self->exchange_frames = itc_kernels.exchange_frames;
+    self->elements_part->set_resonator_render(itc_kernels.render_resonator);
+#ifdef NT_EMU_DEBUG
+    printf("ITC code: %u bytes requested, %s\n", static_cast<unsigned>(req.itc),
+           ptrs.itc ? "copied to ITC" : "running in place");
+#endif
+
     // Initialize default patch parameters (balanced modal sound)
     elements::Patch* patch = self->elements_part->mutable_patch();
 
@@ -310,16 +486,16 @@ static _NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_a
     patch->exciter_strike_level = 0.0f;  // Disabled - uses wavetables
     patch->exciter_strike_meta = 0.5f;
     patch->exciter_strike_timbre = 0.5f;
-    patch->exciter_signature = 0.0f;  // Default signature (will be set by parameterChanged)
+    patch->exciter_signature = 0.0f;  // Default signature (will be set by step())
 
     // Resonator defaults (matching NT parameter defaults: 50%, 70%, 60%)
-    // parameterChanged() will be called after construct() to sync with actual parameter values
+    // The first step() overwrites the mapped fields with the actual parameter values
     patch->resonator_geometry = 0.5f;    // 50% default
     patch->resonator_brightness = 0.7f;  // 70% default
     patch->resonator_damping = 0.6f;     // 60% default
     patch->resonator_position = 0.5f;
     patch->resonator_modulation_frequency = 0.5f;
-    patch->resonator_modulation_offset = 0.015f;  // 10% default * 0.15 scale (will be set by parameterChanged)
+    patch->resonator_modulation_offset = 0.015f;  // 10% default * 0.15 scale (will be set by step())
 
     // Reverb defaults
     patch->reverb_diffusion = 0.7f;
@@ -328,6 +504,9 @@ static _NT_algorithm* construct(const _NT_algorithmMemoryPtrs& ptrs, const _NT_a
 
     patch->modulation_frequency = 0.5f;
 
+    // Morph snapshots start as the default patch; Edit A/B fill the mapped fields
+    self->patch_morph.init(*patch);
+
     return self;
 }
 
@@ -344,86 +523,21 @@ static void parameterChanged(_NT_algorithm* self, int p) {
         return;  // Plugin being destroyed during reload
     }
 
-    elements::Patch* patch = algo->elements_part->mutable_patch();
-
-    // Convert NT parameters (0-100%) to Elements Patch fields (0.0-1.0)
-    switch (p) {
-        // Page 1 - Exciter parameters
-        case kParamBowLevel:
-            patch->exciter_bow_level = parameter_adapter::ntToElements(self->v[kParamBowLevel]);
-            break;
-
-        case kParamBlowLevel:
-            patch->exciter_blow_level = parameter_adapter::ntToElements(self->v[kParamBlowLevel]);
-            break;
-
-        case kParamStrikeLevel:
-            patch->exciter_strike_level = parameter_adapter::ntToElements(self->v[kParamStrikeLevel]);
-            break;
-
-        case kParamBowTimbre:
-            patch->exciter_bow_timbre = parameter_adapter::ntToElements(self->v[kParamBowTimbre]);
-            break;
-
-        case kParamBlowTimbre:
-            patch->exciter_blow_timbre = parameter_adapter::ntToElements(self->v[kParamBlowTimbre]);
-            break;
-
-        case kParamStrikeTimbre:
-            patch->exciter_strike_timbre = parameter_adapter::ntToElements(self->v[kParamStrikeTimbre]);
-            break;
-
-        case kParamBlowFlow:
-            patch->exciter_blow_meta = parameter_adapter::ntToElements(self->v[kParamBlowFlow]);
-            break;
-
-        case kParamStrikeMallet:
-            patch->exciter_strike_meta = parameter_adapter::ntToElements(self->v[kParamStrikeMallet]);
-            break;
-
-        // Page 2 - Resonator parameters
-        case kParamGeometry:
-            patch->resonator_geometry = parameter_adapter::ntToElements(self->v[kParamGeometry]);
-            break;
-
-        case kParamBrightness:
-            patch->resonator_brightness = parameter_adapter::ntToElements(self->v[kParamBrightness]);
-            break;
-
-        case kParamDamping:
-            patch->resonator_damping = parameter_adapter::ntToElements(self->v[kParamDamping]);
-            break;
-
-        case kParamResonatorPosition:
-            patch->resonator_position = parameter_adapter::ntToElements(self->v[kParamResonatorPosition]);
-            break;
-
-        case kParamInharmonicity:
-            patch->resonator_modulation_frequency = parameter_adapter::ntToElements(self->v[kParamInharmonicity]);
-            break;
-
-        // Page 3 - Space (Reverb) parameters
-        case kParamReverbAmount:
-            patch->space = parameter_adapter::ntToElements(self->v[kParamReverbAmount]);
-            break;
-
-        case kParamReverbSize:
-            patch->reverb_lp = parameter_adapter::ntToElements(self->v[kParamReverbSize]);
-            break;
-
-        case kParamReverbDamping:
-            patch->reverb_diffusion = parameter_adapter::ntToElements(self->v[kParamReverbDamping]);
-            break;
-
-        // Additional synthesis parameters
-        case kParamSignature:
-            patch->exciter_signature = parameter_adapter::ntToElements(self->v[kParamSignature]);
-            break;
+    // Patch fields are written by step(), once per block (see patch_mapping.h)
+    const int mapping = patchMappingIndex(p);
+    if (mapping >= 0) {
+        algo->patch_dirty |= 1u << mapping;
+        return;
+    }
 
-        case kParamStereoMod:
-            patch->resonator_modulation_offset = parameter_adapter::ntToElements(self->v[kParamStereoMod]) * 0.15f;  // Scale to 0-0.15 range
-            break;
+    // Modulation matrix slots are compacted by step() before its next block
+    if (p >= kParamModSource1 && p <= kParamModDepth8) {
+        algo->mod_matrix_dirty = true;
+        return;
+    }
 
+    // Everything else is plugin state read by step()
+    switch (p) {
         // Page 4 - Performance parameters
         case kParamCoarseTune:
         case kParamFineTune:
@@ -449,8 +563,9 @@ static void parameterChanged(_NT_algorithm* self, int p) {
             algo->fm_amount = parameter_adapter::ntToElements(self->v[kParamFMAmount]);
             break;
 
-        case kParamExciterContour:
-            patch->exciter_envelope_shape = parameter_adapter::ntToElements(self->v[kParamExciterContour]);
+        case kParamMorphMode:
+            // Edit A/B store every field, Morph and Off retarget every field
+            algo->patch_dirty |= kAllPatchMappings;
             break;
 
         case kParamStrength:
@@ -461,6 +576,19 @@ static void parameterChanged(_NT_algorithm* self, int p) {
             algo->elements_part->set_easter_egg(self->v[kParamEasterEgg] > 0);
             break;
 
+        // CPU budget is read by the governor once per step()
+        case kParamCpuBudget:
+            break;
+
+        // The bank is plugin-wide: a change on any running instance switches
+        // every instance. Values set before an instance's first step() (its
+        // defaults when it is added) are not applied; see step()
+        case kParamSampleBank:
+            if (algo->sample_bank_live) {
+                algo->sample_manager->setSampleBank(self->v[kParamSampleBank]);
+            }
+            break;
+
         // Bus routing and CV input parameters don't need handling (used directly in step())
         case kParamBlowInputBus:
         case kParamStrikeInputBus:
@@ -474,11 +602,114 @@ static void parameterChanged(_NT_algorithm* self, int p) {
         case kParamFMCV:
         case kParamBrightnessCV:
         case kParamExpressionCV:
+        case kParamMorph:
+        case kParamMorphCV:
         default:
             break;
     }
 }
 
+// Retarget the Patch fields whose parameter changed or that are under CV,
+// combining pot and CV in one pass (once per Elements block, CV read at
+// `frame`; see patch_mapping.h), then advance their smoothing ramps. Fields
+// that just lost their CV glide back to the pot value.
+static void applyPatch(nt_elementsAlgorithm* algo, const float* busFrames, int numFrames, int frame) {
+    // Additive offsets in units of each mapping's range (Brightness CV and
+    // the modulation matrix); only entries in `additive` are valid
+    float offsets[kNumPatchMappings];
+    uint32_t additive = algo->mod_matrix.process(busFrames, numFrames, frame, offsets);
+    float expr_mod = 1.0f;
+    uint32_t modulated = additive;
+
+    const int brightness_cv_bus = static_cast<int>(algo->v[kParamBrightnessCV]) - 1;
+    if (brightness_cv_bus >= 0 && brightness_cv_bus < 28) {
+        // CV range: -5V to +5V modulates brightness (bipolar)
+        const float bright_mod = fmaxf(-1.0f, fminf(1.0f, busFrames[brightness_cv_bus * numFrames + frame] * 0.2f));
+        for (uint32_t mask = patchModulationMask(kModBrightnessCV); mask; mask &= mask - 1) {
+            const int i = __builtin_ctz(mask);
+            offsets[i] = (additive & (1u << i)) ? offsets[i] + bright_mod : bright_mod;
+        }
+        additive |= patchModulationMask(kModBrightnessCV);
+    }
+
+    const int expression_cv_bus = static_cast<int>(algo->v[kParamExpressionCV]) - 1;
+    if (expression_cv_bus >= 0 && expression_cv_bus < 28) {
+        // CV range: 0-10V scales the exciter levels (unipolar)
+        expr_mod = fmaxf(0.0f, fminf(1.0f, busFrames[expression_cv_bus * numFrames + frame] * 0.1f));
+        modulated |= patchModulationMask(kModExpressionCV);
+    }
+    modulated |= additive;
+
+    uint32_t apply = algo->patch_dirty;
+    algo->patch_dirty = 0;
+    apply |= modulated | algo->patch_modulated;
+    algo->patch_modulated = modulated;
+
+    // Morph: base values come from the A/B blend instead of the pots.
+    // Edit A/B: the pot values are stored into that snapshot as well.
+    const int morph_mode = static_cast<int>(algo->v[kParamMorphMode]);
+    const bool morphing = morph_mode == kMorphOn;
+    if (morphing) {
+        // CV range: 0-10V adds 0-100% to the Morph position
+        float position = parameter_adapter::ntToElements(algo->v[kParamMorph]);
+        const int morph_cv_bus = static_cast<int>(algo->v[kParamMorphCV]) - 1;
+        if (morph_cv_bus >= 0 && morph_cv_bus < 28) {
+            position += busFrames[morph_cv_bus * numFrames + frame] * 0.1f;
+        }
+        if (algo->patch_morph.process(fmaxf(0.0f, fminf(1.0f, position)))) {
+            apply |= kAllPatchMappings;
+        }
+    }
+    const int edit_slot = morph_mode == kMorphEditA ? PatchMorph::kSlotA :
+                          morph_mode == kMorphEditB ? PatchMorph::kSlotB : -1;
+
+    while (apply) {
+        const int i = __builtin_ctz(apply);
+        apply &= apply - 1;
+
+        const PatchMapping& mapping = kPatchMappings[i];
+        float value;
+        if (morphing) {
+            value = algo->patch_morph.value(i);
+        } else {
+            value = patchMappingValue(mapping, algo->v[mapping.param]);
+            if (edit_slot >= 0) {
+                algo->patch_morph.store(edit_slot, i, value);
+            }
+        }
+        if (modulated & (1u << i)) {
+            if (mapping.modulation == kModExpressionCV) {
+                value *= expr_mod;
+            }
+            if (additive & (1u << i)) {
+                value += offsets[i] * mapping.scale;
+            }
+            // One clamp for all the CV applied to this field
+            value = fmaxf(mapping.offset, fminf(mapping.offset + mapping.scale, value));
+        }
+        algo->patch_smoother.setTarget(i, value);
+    }
+
+    // Fields glide to their targets and stop changing once settled
+    algo->patch_smoother.process(algo->elements_part->mutable_patch());
+}
+
+// Output for a step() that returns before running Elements: buses in replace
+// mode are cleared, so they don't pass on what was there before; buses in add
+// mode are left as they are
+static void writeSilence(const _NT_algorithm* self, float* busFrames, int numFrames) {
+    const int outputs[2][2] = {
+        { kParamOutputBus, kParamOutputMode },
+        { kParamAuxOutputBus, kParamAuxOutputMode },
+    };
+    for (int i = 0; i < 2; ++i) {
+        const int bus = static_cast<int>(self->v[outputs[i][0]]) - 1;
+        if (bus >= 0 && bus < 28 && self->v[outputs[i][1]] == 1) {
+            memset(busFrames + bus * numFrames, 0, numFrames * sizeof(float));
+        }
+    }
+}
+
 static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
     // Defensive validation: Check for null pointers (protection against emulator reload race conditions)
     if (!self || !busFrames) {
@@ -493,28 +724,57 @@ static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
         return;  // Plugin being destroyed during reload
     }
 
+#ifdef NT_ELEMENTS_FIXED_SAMPLE_RATE
+    // The DSP constants of this build are folded for one rate; at any other
+    // host rate it would run detuned, so it stays silent (the display says why)
+    if (NT_globals.sampleRate != NT_ELEMENTS_FIXED_SAMPLE_RATE) {
+        writeSilence(self, busFrames, numFramesBy4 * 4);
+        return;
+    }
+#endif
+
+    // Nothing runs until the LUTs are in place; this also keeps the sample
+    // manager off the card while the LUT image is being read
+    if (!s_lutLoader.poll(dspSampleRate(), numFramesBy4 * 4)) {
+        writeSilence(self, busFrames, numFramesBy4 * 4);
+        return;
+    }
+
+    // Follow the host sample rate once per step(): kSampleRate is cached for
+    // the DSP and the rate-dependent LUTs are swapped (32/48/96kHz are
+    // cached; this is a compare when the rate is unchanged)
+    updateSampleRate();
+    lutGeneratorSetSampleRate(dspSampleRate());
+
+    // The hot-LUT globals are shared: point them at this instance's copies
+    // (refreshed after a rate change)
+    lutHotBind(algo->lut_copies);
+
     // Non-blocking sample loading via state machine
-    // Per distingNT API: "All built-in algorithms watch for card (un)mount in step()"
-    bool sd_mounted = NT_isSdCardMounted();
-    if (!sd_mounted && algo->sd_card_was_mounted) {
-        // SD card just unmounted - reset sample manager for potential reload
-        algo->sample_manager.reset();
-        // Reset global pointers to point to zero-filled buffers
-        elements::smp_sample_data_ptr = algo->sample_manager.getSampleData();
-        elements::smp_noise_sample_ptr = algo->sample_manager.getNoiseSample();
-        elements::smp_boundaries_ptr = algo->sample_manager.getBoundaries();
-    }
-    algo->sd_card_was_mounted = sd_mounted;
-
-    // Call loadStep() each frame - it's non-blocking and manages its own state machine
-    // Samples will load progressively over multiple step() calls
-    if (algo->sample_manager.loadStep()) {
-        // Samples just loaded (or already loaded) - update global pointers for Elements DSP
-        // These pointers are used by exciter.cc via macros in resources.h
-        elements::smp_sample_data_ptr = algo->sample_manager.getSampleData();
-        elements::smp_noise_sample_ptr = algo->sample_manager.getNoiseSample();
-        elements::smp_boundaries_ptr = algo->sample_manager.getBoundaries();
+    // Call loadStep() each frame - it's non-blocking, handles SD card (un)mount and
+    // manages its own state machine. Samples load progressively over multiple step()
+    // calls into the shared buffers. Only the wavetables the MALLET settings of
+    // the instances can reach are loaded (on demand, evicting ones no longer in
+    // use), and each region is playable as soon as it lands.
+    // The Mallet field ramps, so the wavetable comes from where it is heading
+    // rather than from the values it passes through
+    algo->sample_manager->setPreferredWavetable(SampleManager::wavetableForStrikeMeta(
+        algo->patch_smoother.target(patchMappingIndex(kParamStrikeMallet))));
+    if (!algo->sample_bank_live) {
+        // The first instance brings its Sample Bank; later ones join the
+        // bank in use (draw() shows it in their parameter)
+        algo->sample_bank_live = true;
+        if (!s_sampleBankChosen) {
+            s_sampleBankChosen = true;
+            algo->sample_manager->setSampleBank(self->v[kParamSampleBank]);
+        }
     }
+    algo->sample_manager->loadStep(algo);
+    // A bank swap moves every table, so all of them are re-read here
+    elements::smp_wavetable_data_ptr = algo->sample_manager->getWavetableData();
+    elements::smp_wavetable_size_ptr = algo->sample_manager->getWavetableSizes();
+    elements::smp_noise_sample_ptr = algo->sample_manager->getNoiseSample();
+    elements::smp_boundaries_ptr = algo->sample_manager->getBoundaries();
 
     // Apply pending MIDI updates atomically (thread-safe)
     if (algo->pending_update) {
@@ -599,31 +859,10 @@ static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
         algo->perf_state.modulation += fm_mod * fm_range;
     }
 
-    // Apply CV modulation to patch parameters (control-rate using first sample)
-    elements::Patch* patch = algo->elements_part->mutable_patch();
-
-    // Brightness CV modulation
-    const int brightness_cv_bus = static_cast<int>(self->v[kParamBrightnessCV]) - 1;
-    if (brightness_cv_bus >= 0 && brightness_cv_bus < 28 && busFrames) {
-        const float* brightness_cv = busFrames + (brightness_cv_bus * numFrames);
-        // CV range: -5V to +5V modulates brightness (bipolar)
-        float bright_mod = fmaxf(-1.0f, fminf(1.0f, brightness_cv[0] * 0.2f));
-        patch->resonator_brightness = fmaxf(0.0f, fminf(1.0f,
-            parameter_adapter::ntToElements(self->v[kParamBrightness]) + bright_mod));
-    }
-
-    // Expression CV modulation (affects exciter levels)
-    const int expression_cv_bus = static_cast<int>(self->v[kParamExpressionCV]) - 1;
-    if (expression_cv_bus >= 0 && expression_cv_bus < 28 && busFrames) {
-        const float* expression_cv = busFrames + (expression_cv_bus * numFrames);
-        // CV range: 0-10V modulates exciter strength (unipolar)
-        // Scale 0-10V to 0.0-1.0 multiplier
-        float expr_mod = fmaxf(0.0f, fminf(1.0f, expression_cv[0] * 0.1f));
-
-        // Apply expression to active exciter levels
-        patch->exciter_bow_level = parameter_adapter::ntToElements(self->v[kParamBowLevel]) * expr_mod;
-        patch->exciter_blow_level = parameter_adapter::ntToElements(self->v[kParamBlowLevel]) * expr_mod;
-        patch->exciter_strike_level = parameter_adapter::ntToElements(self->v[kParamStrikeLevel]) * expr_mod;
+    // Compact the modulation matrix slots after a slot parameter changed
+    if (algo->mod_matrix_dirty) {
+        algo->mod_matrix_dirty = false;
+        algo->mod_matrix.configure(self->v);
     }
 
 #ifdef NT_EMU_DEBUG
@@ -662,46 +901,61 @@ static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
         return;
     }
 
+    // Let Elements skip the diffuser when nothing is routed to the blow input
+    // and the blow exciter is silent (see elements-exciter-elision.patch)
+    algo->elements_part->set_blow_input_connected(blowInput != nullptr);
+
+    // Update the governor's per-block cycle budget (timed against the last
+    // step(); 100% without a cycle counter) and the Patch smoothing
+    // coefficient (sample rate may have changed)
+    algo->cpu_governor.recordStep(CpuGovernor::readCycleCounter(), numFrames,
+                                  NT_globals.sampleRate);
+    algo->cpu_governor.setBudget(
+        s_cycleCounterRunning ? parameter_adapter::ntToElements(self->v[kParamCpuBudget]) : 1.0f,
+        NT_globals.sampleRate, kElementsBlockSize);
+    algo->patch_smoother.setSampleRate(NT_globals.sampleRate, kElementsBlockSize);
+
     // Elements DSP requires exactly 16 samples per block.
     // We accumulate input until we have 16 samples, then process through Elements.
     // The emulator guarantees outputs are read before processing, so single buffering works.
-
-    for (int i = 0; i < numFrames; ++i) {
-        // Store input samples in accumulation buffers
-        // Blow input: Goes through diffusion → envelope → STRENGTH VCA → resonator
-        // Strike input: Goes directly to resonator (unprocessed)
-        algo->blow_input_buffer[algo->buffer_pos] = blowInput ? blowInput[i] : 0.0f;
-        algo->strike_input_buffer[algo->buffer_pos] = strikeInput ? strikeInput[i] : 0.0f;
-
-        // Output from buffer (filled in previous processing cycle)
-        // Scale by 5.0f for Eurorack standard ±5V levels (Elements outputs normalized -1.0 to +1.0)
-        float main_out = algo->output_main[algo->buffer_pos] * algo->output_level_scale * 5.0f;
-        float aux_out = algo->output_aux[algo->buffer_pos] * algo->output_level_scale * 5.0f;
-
-        if (outputMode == 1) {
-            output[i] = main_out;  // Replace mode
-        } else {
-            output[i] += main_out;  // Mix mode
-        }
-
-        if (auxOutputMode == 1) {
-            auxOutput[i] = aux_out;  // Replace mode
-        } else {
-            auxOutput[i] += aux_out;  // Mix mode
+    // Frames are moved in runs up to the next block boundary by the ITC kernel.
+    FrameExchange exchange;
+    exchange.blow_in = blowInput;
+    exchange.strike_in = strikeInput;
+    exchange.main_out = output;
+    exchange.aux_out = auxOutput;
+    exchange.blow_buffer = algo->blow_input_buffer;
+    exchange.strike_buffer = algo->strike_input_buffer;
+    exchange.main_buffer = algo->output_main;
+    exchange.aux_buffer = algo->output_aux;
+    // Scale by 5.0f for Eurorack standard ±5V levels (Elements outputs normalized -1.0 to +1.0)
+    exchange.gain = algo->output_level_scale * 5.0f;
+    exchange.replace_main = (outputMode == 1);
+    exchange.replace_aux = (auxOutputMode == 1);
+
+    int frame = 0;
+    while (frame < numFrames) {
+        int count = kElementsBlockSize - algo->buffer_pos;
+        if (count > numFrames - frame) {
+            count = numFrames - frame;
         }
-
-        // Advance buffer position
-        algo->buffer_pos++;
+        algo->exchange_frames(exchange, frame, algo->buffer_pos, count);
+        frame += count;
+        algo->buffer_pos += count;
 
         // When we've accumulated 16 samples, process through Elements
         if (algo->buffer_pos >= kElementsBlockSize) {
             algo->buffer_pos = 0;
 
+            // Patch fields for this block, with CV read at its last frame
+            applyPatch(algo, busFrames, numFrames, frame - 1);
+
             // Copy accumulated inputs to Elements temp buffers
             memcpy(algo->temp_blow_in, algo->blow_input_buffer, kElementsBlockSize * sizeof(float));
             memcpy(algo->temp_strike_in, algo->strike_input_buffer, kElementsBlockSize * sizeof(float));
 
-            // Process full block through Elements DSP
+            // Process full block through Elements DSP (timed for the CPU governor)
+            uint32_t block_start = CpuGovernor::readCycleCounter();
             algo->elements_part->Process(
                 algo->perf_state,
                 algo->temp_blow_in,
@@ -710,6 +964,12 @@ static void step(_NT_algorithm* self, float* busFrames, int numFramesBy4) {
                 algo->output_aux,
                 static_cast<size_t>(kElementsBlockSize)
             );
+
+            // Shed or restore resonator modes when the measured cost leaves the budget
+            if (algo->cpu_governor.recordBlock(CpuGovernor::readCycleCounter() - block_start)) {
+                algo->elements_part->set_resolution(
+                    static_cast<size_t>(algo->cpu_governor.activeModes()));
+            }
         }
     }
 
@@ -731,6 +991,14 @@ static bool draw(_NT_algorithm* self) {
         return false;  // Plugin being destroyed during reload
     }
 
+    // The Sample Bank is plugin-wide: show the bank in use in this instance's
+    // parameter too (it differs after a change on another instance or a bank
+    // that couldn't be loaded), so edits start from it
+    const int32_t bank = algo->sample_manager->getSampleBank();
+    if (algo->sample_bank_live && self->v[kParamSampleBank] != bank) {
+        NT_setParameterFromUi(NT_algorithmIndex(self), kParamSampleBank + NT_parameterOffset(), bank);
+    }
+
     // Always render the display (distingNT calls draw() continuously)
     oled_display::renderDisplay(algo);
 
@@ -884,6 +1152,90 @@ static void setupUi(_NT_algorithm* self, _NT_float3& pots) {
     }
 }
 
+// Morph snapshot member names in the preset JSON
+static const char* const kMorphSnapshotNames[PatchMorph::kNumSlots] = { "morphA", "morphB" };
+
+// Sample Bank member name in the preset JSON
+static const char* const kSampleBankName = "sampleBank";
+
+// Save the morph snapshots and the Sample Bank with the preset. Each
+// snapshot is an object keyed by mapping name, so a preset still loads into
+// the right fields after kPatchMappings is reordered or extended
+static void serialise(_NT_algorithm* self, _NT_jsonStream& stream) {
+    nt_elementsAlgorithm* algo = static_cast<nt_elementsAlgorithm*>(self);
+
+    for (int slot = 0; slot < PatchMorph::kNumSlots; ++slot) {
+        const elements::Patch& snapshot = algo->patch_morph.snapshot(slot);
+        stream.addMemberName(kMorphSnapshotNames[slot]);
+        stream.openObject();
+        for (int i = 0; i < kNumPatchMappings; ++i) {
+            stream.addMemberName(kPatchMappingNames[i]);
+            stream.addNumber(snapshot.*kPatchMappings[i].field);
+        }
+        stream.closeObject();
+    }
+
+    // The plugin-wide Sample Bank, so a preset brings back the bank it used
+    stream.addMemberName(kSampleBankName);
+    stream.addNumber(static_cast<int>(algo->sample_manager->getSampleBank()));
+}
+
+static bool deserialise(_NT_algorithm* self, _NT_jsonParse& parse) {
+    nt_elementsAlgorithm* algo = static_cast<nt_elementsAlgorithm*>(self);
+
+    int numMembers;
+    if (!parse.numberOfObjectMembers(numMembers)) {
+        return false;
+    }
+
+    for (int member = 0; member < numMembers; ++member) {
+        if (parse.matchName(kSampleBankName)) {
+            int bank;
+            if (!parse.number(bank)) {
+                return false;
+            }
+            s_sampleBankChosen = true;
+            algo->sample_manager->setSampleBank(bank);
+            continue;
+        }
+
+        int slot = 0;
+        while (slot < PatchMorph::kNumSlots && !parse.matchName(kMorphSnapshotNames[slot])) {
+            ++slot;
+        }
+        if (slot == PatchMorph::kNumSlots) {
+            if (!parse.skipMember()) {
+                return false;
+            }
+            continue;
+        }
+
+        int numValues;
+        if (!parse.numberOfObjectMembers(numValues)) {
+            return false;
+        }
+        elements::Patch& snapshot = algo->patch_morph.mutableSnapshot(slot);
+        for (int value = 0; value < numValues; ++value) {
+            int i = 0;
+            while (i < kNumPatchMappings && !parse.matchName(kPatchMappingNames[i])) {
+                ++i;
+            }
+            // Fields of another build's mappings are skipped; fields the
+            // preset lacks keep their current value
+            if (i == kNumPatchMappings) {
+                if (!parse.skipMember()) {
+                    return false;
+                }
+                continue;
+            }
+            if (!parse.number(snapshot.*kPatchMappings[i].field)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
 static void midiMessage(_NT_algorithm* self, uint8_t b0, uint8_t b1, uint8_t b2) {
     // Defensive validation: Check for null pointer (protection against emulator reload race conditions)
     if (!self) {
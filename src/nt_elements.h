@@ -14,6 +14,12 @@
 #include "distingnt/api.h"
 #include "elements/dsp/part.h"
 #include "sample_manager.h"
+#include "cpu_governor.h"
+#include "mod_matrix.h"
+#include "patch_smoother.h"
+#include "patch_morph.h"
+#include "itc_code.h"
+#include "lut_generator.h"
 
 // Elements requires exactly 16 samples per block
 static constexpr int kElementsBlockSize = 16;
@@ -41,14 +47,24 @@ struct nt_elementsAlgorithm : public _NT_algorithm {
     float output_aux[kElementsBlockSize];
     int buffer_pos;  // Current position in buffers (0-15)
 
+    // Per-sample bus <-> block buffer exchange (ITC copy, or in place as fallback)
+    ExchangeFramesFn exchange_frames;
+
+    // This instance's copies of the hot LUTs (DTC)
+    LutHotCopies lut_copies;
+
     // Memory region pointers for cleanup tracking
     uint16_t* reverb_buffer;
 
     // Sample manager for loading wavetables and noise samples
-    SampleManager sample_manager;
+    // (shared by all instances, lives in static DRAM)
+    SampleManager* sample_manager;
 
-    // Track SD card mount state for late loading
-    bool sd_card_was_mounted;
+    // This instance has run: its Sample Bank changes apply plugin-wide
+    bool sample_bank_live;
+
+    // Resonator mode governor (keeps per-block cost inside the CPU budget)
+    CpuGovernor cpu_governor;
 
     // MIDI state for monophonic voice management
     uint8_t current_note;
@@ -75,6 +91,25 @@ struct nt_elementsAlgorithm : public _NT_algorithm {
     // FM amount (stored here so it can be applied to perf_state.modulation in step)
     float fm_amount;
 
+    // Patch mappings to write in the next step() (bit i = kPatchMappings[i]).
+    // Set by parameterChanged(), which step() can interrupt but not the
+    // reverse, so a plain read-then-clear in step() loses no bits.
+    volatile uint32_t patch_dirty;
+
+    // Patch mappings that were under CV in the last Elements block
+    uint32_t patch_modulated;
+
+    // CV modulation matrix, recompacted by step() when mod_matrix_dirty is
+    // set (by parameterChanged(), same ordering as patch_dirty)
+    ModMatrix mod_matrix;
+    volatile bool mod_matrix_dirty;
+
+    // Per-block ramps of the mapped Patch fields
+    PatchSmoother patch_smoother;
+
+    // A/B Patch snapshots blended by the Morph parameter
+    PatchMorph patch_morph;
+
     // CV input state
     bool gate_cv_was_high;  // For gate edge detection
 };
@@ -47,6 +47,10 @@ const char* PARAM_NAMES[kNumParams] = {
     "Size",       // kParamReverbSize
     "RvDamp",     // kParamReverbDamping
 
+    // Additional synthesis parameters
+    "Sig",        // kParamSignature
+    "StMod",      // kParamStereoMod
+
     // Performance/Tuning parameters
     "Coarse",     // kParamCoarseTune
     "Fine",       // kParamFineTune
@@ -61,7 +65,45 @@ const char* PARAM_NAMES[kNumParams] = {
     "Gate",       // kParamGateCV
     "FM CV",      // kParamFMCV
     "BrightCV",   // kParamBrightnessCV
-    "Expr"        // kParamExpressionCV
+    "Expr",       // kParamExpressionCV
+
+    // Easter egg
+    "Egg",        // kParamEasterEgg
+
+    // Engine parameters
+    "CPU",        // kParamCpuBudget
+    "Bank",       // kParamSampleBank
+
+    // Modulation matrix
+    "Mod1Src",    // kParamModSource1
+    "Mod1Dst",    // kParamModDest1
+    "Mod1Dep",    // kParamModDepth1
+    "Mod2Src",    // kParamModSource2
+    "Mod2Dst",    // kParamModDest2
+    "Mod2Dep",    // kParamModDepth2
+    "Mod3Src",    // kParamModSource3
+    "Mod3Dst",    // kParamModDest3
+    "Mod3Dep",    // kParamModDepth3
+    "Mod4Src",    // kParamModSource4
+    "Mod4Dst",    // kParamModDest4
+    "Mod4Dep",    // kParamModDepth4
+    "Mod5Src",    // kParamModSource5
+    "Mod5Dst",    // kParamModDest5
+    "Mod5Dep",    // kParamModDepth5
+    "Mod6Src",    // kParamModSource6
+    "Mod6Dst",    // kParamModDest6
+    "Mod6Dep",    // kParamModDepth6
+    "Mod7Src",    // kParamModSource7
+    "Mod7Dst",    // kParamModDest7
+    "Mod7Dep",    // kParamModDepth7
+    "Mod8Src",    // kParamModSource8
+    "Mod8Dst",    // kParamModDest8
+    "Mod8Dep",    // kParamModDepth8
+
+    // Patch morphing
+    "MorphMd",    // kParamMorphMode
+    "Morph",      // kParamMorph
+    "MorphCV",    // kParamMorphCV
 };
 
 // Page title display timing constants (assuming ~60 FPS draw rate)
@@ -303,17 +345,37 @@ void renderParameters(nt_elementsAlgorithm* algo) {
 void renderSampleWarning(nt_elementsAlgorithm* algo) {
     const int BOTTOM_Y = SCREEN_HEIGHT - 8;  // Bottom of screen
 
+#ifdef NT_ELEMENTS_FIXED_SAMPLE_RATE
+    // The DSP constants of this build are folded for one rate; step() is
+    // silent at any other
+    if (NT_globals.sampleRate != NT_ELEMENTS_FIXED_SAMPLE_RATE) {
+        char message[24];
+        snprintf(message, sizeof(message), "Built for %ukHz",
+                 static_cast<unsigned>(NT_ELEMENTS_FIXED_SAMPLE_RATE / 1000));
+        NT_drawText(SCREEN_WIDTH / 2, BOTTOM_Y, message, TEXT_COLOR, kNT_textCentre, kNT_textTiny);
+        return;
+    }
+#endif
+
     // Check if samples are loaded using the sample manager
-    if (!algo->sample_manager.isLoaded()) {
+    if (!algo->sample_manager->isLoaded()) {
         // Get loading state for more specific message
-        SampleManager::LoadState state = algo->sample_manager.getLoadState();
+        SampleManager::LoadState state = algo->sample_manager->getLoadState();
         const char* message;
+        char progress[24];
 
         switch (state) {
-            case SampleManager::LoadState::IDLE:
-            case SampleManager::LoadState::VALIDATING:
             case SampleManager::LoadState::LOADING_WAVETABLE:
             case SampleManager::LoadState::LOADING_NOISE:
+            case SampleManager::LoadState::RESAMPLING:
+                // Progress of the region being read (per chunk) or resampled
+                snprintf(progress, sizeof(progress), "Loading samples %u%%",
+                         static_cast<unsigned>(algo->sample_manager->getLoadProgress()));
+                message = progress;
+                break;
+            case SampleManager::LoadState::IDLE:
+            case SampleManager::LoadState::VALIDATING:
+            case SampleManager::LoadState::LOADING_BANK_INDEX:
                 message = "Loading samples...";
                 break;
             case SampleManager::LoadState::FAILED:
@@ -69,9 +69,40 @@ enum ParameterIndices {
     // Easter egg (OminousVoice FM synthesis mode)
     kParamEasterEgg,         // Easter egg toggle (0=Off, 1=On)
 
+    // Engine parameters
+    kParamCpuBudget,         // CPU budget for resonator governor (10-100%, 100% = unlimited)
+    kParamSampleBank,        // Sample folder (0=elements, 1-3=elements_user1-3)
+
+    // Modulation matrix slots: source CV bus (0=none, 1-28=bus number),
+    // destination (index into kPatchMappings), depth (-100 to +100%)
+    kParamModSource1, kParamModDest1, kParamModDepth1,
+    kParamModSource2, kParamModDest2, kParamModDepth2,
+    kParamModSource3, kParamModDest3, kParamModDepth3,
+    kParamModSource4, kParamModDest4, kParamModDepth4,
+    kParamModSource5, kParamModDest5, kParamModDepth5,
+    kParamModSource6, kParamModDest6, kParamModDepth6,
+    kParamModSource7, kParamModDest7, kParamModDepth7,
+    kParamModSource8, kParamModDest8, kParamModDepth8,
+
+    // Patch morphing
+    kParamMorphMode,         // Morph mode (0=Off, 1=Edit A, 2=Edit B, 3=Morph)
+    kParamMorph,             // Morph position A to B (0-100% -> 0.0-1.0)
+    kParamMorphCV,           // Morph CV input bus (0=none, 1-28=bus number)
+
     kNumParams
 };
 
+// Parameters per modulation matrix slot (source, destination, depth)
+static constexpr int kModSlotParams = kParamModSource2 - kParamModSource1;
+
+// Morph Mode values
+enum MorphMode {
+    kMorphOff = 0,
+    kMorphEditA,
+    kMorphEditB,
+    kMorphOn
+};
+
 // Parameter conversion helpers
 namespace parameter_adapter {
 
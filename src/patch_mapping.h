@@ -0,0 +1,108 @@
+/*
+ * patch_mapping.h - Table-driven mapping of NT parameters to Elements Patch fields
+ *
+ * Every parameter that lands in a Patch field is described once here:
+ * target field, scale and offset from the 0-1 parameter value, and which CV
+ * input (if any) modulates it. parameterChanged() only marks an entry dirty;
+ * step() writes the dirty and CV-modulated entries once per block, so the
+ * pot value and its CV are combined in one place and in one order:
+ *
+ *   value = (v / 100) * scale + offset
+ *   Expression CV: value = value * cv
+ *   Brightness CV: value = value + cv
+ *   Modulation matrix (mod_matrix.h): value = value + sum(cv * depth) * scale
+ *   then, if any CV applied, clamped once to [offset, offset + scale]
+ *
+ * The result is the field's target; patch_smoother.h ramps the field to it.
+ *
+ * Copyright (c) 2025 Neal Sanche
+ * Licensed under MIT License
+ */
+
+#ifndef NT_ELEMENTS_PATCH_MAPPING_H_
+#define NT_ELEMENTS_PATCH_MAPPING_H_
+
+#include <cstdint>
+#include "elements/dsp/part.h"
+#include "parameter_adapter.h"
+
+// CV input that modulates a mapped Patch field
+enum PatchModulation : uint8_t {
+    kModNone,
+    kModBrightnessCV,        // Bipolar, added to the base value
+    kModExpressionCV,        // Unipolar, scales the base value
+};
+
+struct PatchMapping {
+    int param;                           // ParameterIndices
+    float elements::Patch::* field;      // Target Patch field
+    float scale;
+    float offset;
+    PatchModulation modulation;
+};
+
+static constexpr PatchMapping kPatchMappings[] = {
+    // Page 1 - Exciter
+    { kParamBowLevel,          &elements::Patch::exciter_bow_level,              1.0f,  0.0f, kModExpressionCV },
+    { kParamBlowLevel,         &elements::Patch::exciter_blow_level,             1.0f,  0.0f, kModExpressionCV },
+    { kParamStrikeLevel,       &elements::Patch::exciter_strike_level,           1.0f,  0.0f, kModExpressionCV },
+    { kParamBowTimbre,         &elements::Patch::exciter_bow_timbre,             1.0f,  0.0f, kModNone },
+    { kParamBlowTimbre,        &elements::Patch::exciter_blow_timbre,            1.0f,  0.0f, kModNone },
+    { kParamStrikeTimbre,      &elements::Patch::exciter_strike_timbre,          1.0f,  0.0f, kModNone },
+    { kParamBlowFlow,          &elements::Patch::exciter_blow_meta,              1.0f,  0.0f, kModNone },
+    { kParamStrikeMallet,      &elements::Patch::exciter_strike_meta,            1.0f,  0.0f, kModNone },
+    { kParamSignature,         &elements::Patch::exciter_signature,              1.0f,  0.0f, kModNone },
+    { kParamExciterContour,    &elements::Patch::exciter_envelope_shape,         1.0f,  0.0f, kModNone },
+
+    // Page 2 - Resonator
+    { kParamGeometry,          &elements::Patch::resonator_geometry,             1.0f,  0.0f, kModNone },
+    { kParamBrightness,        &elements::Patch::resonator_brightness,           1.0f,  0.0f, kModBrightnessCV },
+    { kParamDamping,           &elements::Patch::resonator_damping,              1.0f,  0.0f, kModNone },
+    { kParamResonatorPosition, &elements::Patch::resonator_position,             1.0f,  0.0f, kModNone },
+    { kParamInharmonicity,     &elements::Patch::resonator_modulation_frequency, 1.0f,  0.0f, kModNone },
+    { kParamStereoMod,         &elements::Patch::resonator_modulation_offset,    0.15f, 0.0f, kModNone },
+
+    // Page 3 - Space
+    { kParamReverbAmount,      &elements::Patch::space,                          1.0f,  0.0f, kModNone },
+    { kParamReverbSize,        &elements::Patch::reverb_lp,                      1.0f,  0.0f, kModNone },
+    { kParamReverbDamping,     &elements::Patch::reverb_diffusion,               1.0f,  0.0f, kModNone },
+};
+
+static constexpr int kNumPatchMappings = sizeof(kPatchMappings) / sizeof(kPatchMappings[0]);
+static_assert(kNumPatchMappings <= 32, "Patch mapping dirty mask is 32 bits");
+
+// Mapping names, in table order (modulation matrix destination enum)
+static const char* const kPatchMappingNames[] = {
+    "Bow Level", "Blow Level", "Strike Level", "Bow Timbre", "Blow Timbre",
+    "Str Timbre", "Flow", "Mallet", "Signature", "Exciter Cnt",
+    "Geometry", "Brightness", "Damping", "Position", "Inharmonic", "Stereo Mod",
+    "Reverb Amt", "Reverb Size", "Reverb Damp",
+    nullptr
+};
+static_assert(sizeof(kPatchMappingNames) / sizeof(kPatchMappingNames[0]) == kNumPatchMappings + 1,
+              "One name per Patch mapping");
+
+// Dirty bits of every mapping (set in construct() so the first block
+// applies the parameter values over the Patch defaults)
+static constexpr uint32_t kAllPatchMappings =
+    kNumPatchMappings == 32 ? 0xFFFFFFFFu : (1u << kNumPatchMappings) - 1;
+
+// Dirty bits of the mappings modulated by one CV input
+static constexpr uint32_t patchModulationMask(PatchModulation modulation, int i = 0) {
+    return i >= kNumPatchMappings ? 0u :
+        ((kPatchMappings[i].modulation == modulation ? (1u << i) : 0u) |
+         patchModulationMask(modulation, i + 1));
+}
+
+// Index of the mapping for an NT parameter, or -1 if it has none
+static constexpr int patchMappingIndex(int param, int i = 0) {
+    return i >= kNumPatchMappings ? -1 :
+        (kPatchMappings[i].param == param ? i : patchMappingIndex(param, i + 1));
+}
+
+// Base value of a mapping from the NT parameter value
+inline float patchMappingValue(const PatchMapping& mapping, float ntValue) {
+    return parameter_adapter::ntToElements(ntValue) * mapping.scale + mapping.offset;
+}
+
+#endif // NT_ELEMENTS_PATCH_MAPPING_H_
@@ -0,0 +1,34 @@
+// Copyright 2025 Neal Sanche
+// SPDX-License-Identifier: MIT
+
+#include "patch_morph.h"
+
+#include <math.h>
+
+void PatchMorph::init(const elements::Patch& patch) {
+    for (int slot = 0; slot < kNumSlots; ++slot) {
+        snapshots_[slot] = patch;
+    }
+    output_ = patch;
+    position_ = 0.0f;
+    changed_ = true;
+}
+
+bool PatchMorph::process(float position) {
+    // Small moves are ignored, except onto the ends so A and B are exact
+    const bool end = (position == 0.0f || position == 1.0f) && position != position_;
+    if (!changed_ && !end && fabsf(position - position_) < kPositionEpsilon) {
+        return false;
+    }
+    changed_ = false;
+    position_ = position;
+
+    // One pass over the Patch as floats (every field is a float)
+    const float* a = reinterpret_cast<const float*>(&snapshots_[kSlotA]);
+    const float* b = reinterpret_cast<const float*>(&snapshots_[kSlotB]);
+    float* out = reinterpret_cast<float*>(&output_);
+    for (size_t i = 0; i < kPatchFloats; ++i) {
+        out[i] = a[i] + (b[i] - a[i]) * position;
+    }
+    return true;
+}
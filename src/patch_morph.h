@@ -0,0 +1,98 @@
+// Copyright 2025 Neal Sanche
+// SPDX-License-Identifier: MIT
+
+#ifndef PATCH_MORPH_H
+#define PATCH_MORPH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "patch_mapping.h"
+
+/**
+ * PatchMorph - Interpolates between two elements::Patch snapshots
+ *
+ * Snapshots A and B are full Patch states. While the Morph Mode parameter
+ * is on Edit A or Edit B, the Patch pass in step() stores the pot value of
+ * every mapped field it writes into that snapshot. In Morph mode, process()
+ * blends the two snapshots into one Patch in a single pass over the struct
+ * as a float array, and the Patch pass takes its base values from the blend
+ * instead of the pots. CV modulation and per-block smoothing still apply on
+ * top, so one Morph CV moves every field with a single loop.
+ *
+ * Snapshots are saved with the preset (serialise() in nt_elements.cpp).
+ *
+ * Usage:
+ *   1. Call init() in construct() with the default Patch
+ *   2. In edit modes, call store() with each mapped field's pot value
+ *   3. In Morph mode, call process() once per Elements block and read
+ *      value() for each mapped field
+ */
+class PatchMorph {
+public:
+    enum Slot {
+        kSlotA,
+        kSlotB,
+        kNumSlots
+    };
+
+    // Position moves smaller than this don't re-blend (CV noise)
+    static constexpr float kPositionEpsilon = 1.0e-4f;
+
+    /**
+     * Set both snapshots to a Patch.
+     */
+    void init(const elements::Patch& patch);
+
+    /**
+     * Store one mapped field in a snapshot.
+     *
+     * @param slot kSlotA or kSlotB
+     * @param mapping Index into kPatchMappings
+     * @param value Field value
+     */
+    void store(int slot, int mapping, float value) {
+        if (snapshots_[slot].*kPatchMappings[mapping].field != value) {
+            snapshots_[slot].*kPatchMappings[mapping].field = value;
+            changed_ = true;
+        }
+    }
+
+    /**
+     * Blend the snapshots if the position or a snapshot changed.
+     *
+     * @param position 0.0 (A) to 1.0 (B)
+     * @return true if the blended Patch changed
+     */
+    bool process(float position);
+
+    /**
+     * Get a mapped field of the blended Patch.
+     */
+    float value(int mapping) const { return output_.*kPatchMappings[mapping].field; }
+
+    /**
+     * Get a snapshot (for serialisation).
+     */
+    const elements::Patch& snapshot(int slot) const { return snapshots_[slot]; }
+
+    /**
+     * Get a snapshot to restore it (for deserialisation).
+     */
+    elements::Patch& mutableSnapshot(int slot) {
+        changed_ = true;
+        return snapshots_[slot];
+    }
+
+private:
+    static_assert(sizeof(elements::Patch) % sizeof(float) == 0,
+                  "Patch is blended as an array of floats");
+    static constexpr size_t kPatchFloats = sizeof(elements::Patch) / sizeof(float);
+
+    elements::Patch snapshots_[kNumSlots];
+    elements::Patch output_;
+    float position_;  // Position output_ was blended at
+    bool changed_;    // A snapshot changed since the last blend
+};
+
+#endif // PATCH_MORPH_H
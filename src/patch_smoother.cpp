@@ -0,0 +1,56 @@
+// Copyright 2025 Neal Sanche
+// SPDX-License-Identifier: MIT
+
+#include "patch_smoother.h"
+
+#include <math.h>
+
+void PatchSmoother::init(const elements::Patch& patch) {
+    for (int i = 0; i < kNumPatchMappings; ++i) {
+        current_[i] = patch.*kPatchMappings[i].field;
+        target_[i] = current_[i];
+    }
+    ramping_ = 0;
+    sampleRate_ = 0;
+    coefficient_ = 1.0f;
+    snap_ = true;
+}
+
+void PatchSmoother::setSampleRate(uint32_t sampleRate, int blockSize) {
+    if (sampleRate == sampleRate_ || sampleRate == 0 || blockSize <= 0) {
+        return;
+    }
+    sampleRate_ = sampleRate;
+    coefficient_ = 1.0f - expf(-static_cast<float>(blockSize) /
+                               (kSmoothingTime * static_cast<float>(sampleRate)));
+}
+
+void PatchSmoother::setTarget(int mapping, float value) {
+    const uint32_t bit = 1u << mapping;
+    if (snap_) {
+        current_[mapping] = value;
+    } else if (!(ramping_ & bit) && value == target_[mapping]) {
+        return;  // Settled on this value already
+    }
+    target_[mapping] = value;
+    ramping_ |= bit;
+}
+
+void PatchSmoother::process(elements::Patch* patch) {
+    snap_ = false;
+
+    uint32_t moving = ramping_;
+    while (moving) {
+        const int i = __builtin_ctz(moving);
+        moving &= moving - 1;
+
+        const PatchMapping& mapping = kPatchMappings[i];
+        float value = current_[i] + (target_[i] - current_[i]) * coefficient_;
+        if (fabsf(target_[i] - value) <= kSettleEpsilon * mapping.scale) {
+            value = target_[i];
+            ramping_ &= ~(1u << i);
+        }
+        current_[i] = value;
+        patch->*mapping.field = value;
+    }
+}
@@ -0,0 +1,92 @@
+// Copyright 2025 Neal Sanche
+// SPDX-License-Identifier: MIT
+
+#ifndef PATCH_SMOOTHER_H
+#define PATCH_SMOOTHER_H
+
+#include <stdint.h>
+
+#include "patch_mapping.h"
+
+/**
+ * PatchSmoother - Per-block one-pole smoothing of the mapped Patch fields
+ *
+ * Pot moves and block-rate CV steps would otherwise land in the Patch as
+ * jumps: zipper noise, and a full resonator filter recompute on every
+ * small step. Each mapped field instead glides toward its target with a
+ * one-pole filter evaluated once per Elements block.
+ *
+ * A field snaps to its target once it is within kSettleEpsilon of its
+ * range and then drops out of the ramp mask, so settled fields cost nothing
+ * and stop changing. The resonator only recomputes its filters while its
+ * inputs change (see elements-filter-settle.patch), so a settled ramp also
+ * ends the recomputes.
+ *
+ * Usage:
+ *   1. Call init() in construct() after the Part's Init(); the first
+ *      targets are then applied without a ramp
+ *   2. Call setSampleRate() once per step()
+ *   3. Call setTarget() for each mapped field whose value may have changed,
+ *      then process() once per Elements block
+ */
+class PatchSmoother {
+public:
+    // Time constant of the one-pole ramp
+    static constexpr float kSmoothingTime = 0.004f;  // 4ms
+
+    // A ramp ends within this fraction of the field's range
+    static constexpr float kSettleEpsilon = 1.0e-4f;
+
+    /**
+     * Clear all ramps; the next targets are written directly.
+     *
+     * @param patch Patch the fields start from (also the targets until the
+     *              first setTarget())
+     */
+    void init(const elements::Patch& patch);
+
+    /**
+     * Update the per-block coefficient for the sample rate.
+     *
+     * @param sampleRate Current NT sample rate in Hz
+     * @param blockSize Elements block size in samples
+     */
+    void setSampleRate(uint32_t sampleRate, int blockSize);
+
+    /**
+     * Set the value a mapped field should glide to.
+     *
+     * @param mapping Index into kPatchMappings
+     * @param value Target value of the field
+     */
+    void setTarget(int mapping, float value);
+
+    /**
+     * Advance the ramps by one block and write the moving fields.
+     *
+     * @param patch Patch to write
+     */
+    void process(elements::Patch* patch);
+
+    /**
+     * Get the value a mapped field is gliding to (its value once settled).
+     *
+     * @param mapping Index into kPatchMappings
+     */
+    float target(int mapping) const { return target_[mapping]; }
+
+    /**
+     * Get the mask of the fields still ramping.
+     */
+    uint32_t ramping() const { return ramping_; }
+
+private:
+    float current_[kNumPatchMappings];
+    float target_[kNumPatchMappings];
+    uint32_t ramping_;     // Fields moving toward their target
+    uint32_t sampleRate_;  // Rate coefficient_ was computed for
+    float coefficient_;
+    bool snap_;            // Write the next targets without a ramp
+};
+
+#endif // PATCH_SMOOTHER_H
@@ -3,25 +3,11 @@
 
 #include "sample_manager.h"
 #include <distingnt/api.h>
+#include <stdio.h>
 #include <string.h>
 
-// Precomputed boundary values from original Elements resources.cc
-// These define the start offset of each wavetable region in sampleData_
-static const size_t kDefaultBoundaries[SampleManager::kNumBoundaries] = {
-    0,       // Start of wavetable 0
-    17099,   // Start of wavetable 1
-    20852,   // Start of wavetable 2
-    30369,   // Start of wavetable 3
-    63050,   // Start of wavetable 4
-    85807,   // Start of wavetable 5
-    95952,   // Start of wavetable 6
-    106297,  // Start of wavetable 7
-    117606,  // Start of wavetable 8
-    128013   // End of last wavetable (total size)
-};
-
-// Expected sample file names in the elements folder
-// Files must be in this exact order: wavetable_00.wav through wavetable_08.wav, then noise.wav
+// Expected sample file names in a sample folder
+// wavetable_00.wav through wavetable_08.wav, then noise.wav (any order on disk)
 static const char* const kExpectedFileNames[] = {
     "wavetable_00.wav",
     "wavetable_01.wav",
@@ -35,76 +21,336 @@ static const char* const kExpectedFileNames[] = {
     "noise.wav"
 };
 
-// Expected frame counts for validation
-static const uint32_t kExpectedFrameCounts[] = {
-    17099,   // wavetable_00.wav
-    3753,    // wavetable_01.wav (20852 - 17099)
-    9517,    // wavetable_02.wav (30369 - 20852)
-    32681,   // wavetable_03.wav (63050 - 30369)
-    22757,   // wavetable_04.wav (85807 - 63050)
-    10145,   // wavetable_05.wav (95952 - 85807)
-    10345,   // wavetable_06.wav (106297 - 95952)
-    11309,   // wavetable_07.wav (117606 - 106297)
-    10407,   // wavetable_08.wav (128013 - 117606)
-    40963    // noise.wav
-};
+#ifdef NT_ELEMENTS_RESAMPLE_SAMPLES
+#ifdef NT_ELEMENTS_MULAW_SAMPLES
+// G.711 mu-law, matching scripts/compress_samples.py and lut_mulaw_decode
+static inline int32_t decodeSample(uint8_t sample) {
+    int32_t code = ~sample & 0xFF;
+    int32_t exponent = (code >> 4) & 0x07;
+    int32_t magnitude = ((((code & 0x0F) << 3) + 0x84) << exponent) - 0x84;
+    return (code & 0x80) ? -magnitude : magnitude;
+}
+
+static inline uint8_t encodeSample(int32_t sample) {
+    int32_t sign = sample < 0 ? 0x80 : 0;
+    int32_t magnitude = (sample < 0 ? -sample : sample);
+    magnitude = (magnitude > 32635 ? 32635 : magnitude) + 0x84;
+    int32_t exponent = 7;
+    while (exponent > 0 && !(magnitude & (0x4000 >> (7 - exponent)))) {
+        --exponent;
+    }
+    int32_t mantissa = (magnitude >> (exponent + 3)) & 0x0F;
+    return static_cast<uint8_t>(~(sign | (exponent << 4) | mantissa) & 0xFF);
+}
+#else
+static inline int32_t decodeSample(int16_t sample) {
+    return sample;
+}
+
+static inline int16_t encodeSample(int32_t sample) {
+    return static_cast<int16_t>(sample);
+}
+#endif
+#endif
 
-void SampleManager::init(int16_t* dramBuffer) {
+void SampleManager::init(Sample* dramBuffer) {
     // Set up pointers into DRAM buffer
-    sampleData_ = dramBuffer;
-    noiseSample_ = dramBuffer + kSampleDataSize;
+    pool_ = dramBuffer;
+    Sample* noiseBuffers = pool_ + kWavetablePoolSamples;
+    silentPage_ = noiseBuffers + kNumSets * kNoiseBufferSamples;
 
-    // Zero all memory (samples will be zeros if loading fails)
-    memset(sampleData_, 0, kSampleDataSize * sizeof(int16_t));
-    memset(noiseSample_, 0, kNoiseSampleSize * sizeof(int16_t));
+    // Fill the silent page once (initialise() runs off the audio thread).
+    // The pool and noise buffers are never read before a load fills them.
+    memset(silentPage_, kSilenceByte, kSilentPageSamples * sizeof(Sample));
 
-    // Initialize boundaries with default values
-    memcpy(boundaries_, kDefaultBoundaries, sizeof(boundaries_));
+    // Nothing is resident yet
+    for (uint32_t s = 0; s < kNumSets; s++) {
+        SampleSet& set = sets_[s];
+        set.noiseBuffer = noiseBuffers + s * kNoiseBufferSamples;
+        releaseSet(set);
+        memset(set.lastWanted, 0, sizeof(set.lastWanted));
+        memset(set.fileIndices, 0, sizeof(set.fileIndices));
+        set.folderIndex = 0;
+    }
+    active_ = 0;
+    target_ = 0;
+    requestedBank_ = 0;
+    sets_[0].bank = 0;
+    tick_ = 0;
 
     // Initialize state machine
     loadState_ = LoadState::IDLE;
-    folderIndex_ = 0;
     currentFileIndex_ = 0;
+    currentLead_ = 0;
+    regionSource_ = 0;
+    regionDst_ = nullptr;
+    regionStartFrame_ = 0;
+    regionFrames_ = 0;
+    regionFramesDone_ = 0;
+    chunkFrames_ = 0;
+    chunkRetries_ = 0;
+    regionSamples_ = 0;
+    draining_ = false;
+    drainCounter_ = 0;
+    reportedMask_ = 0;
+    preferredMask_ = 0;
+    deferredMask_ = 0;
     callbackPending_ = false;
     callbackSuccess_ = false;
 
+#ifdef NT_ELEMENTS_RESAMPLE_SAMPLES
+    preparedStep_ = hostRateStep();
+    resampleSource_ = 0;
+    resampleRemaining_ = 0;
+#endif
+
     // Initialize retry state
     retryCount_ = 0;
     retryDelayCounter_ = 0;
 
-    // Zero the request structure
-    memset(&currentRequest_, 0, sizeof(currentRequest_));
+    // Zero the request structures
+    memset(requests_, 0, sizeof(requests_));
+    request_ = 0;
+
+    // Name hashes for the folder scan
+    for (uint32_t entry = 0; entry < kNumExpectedNames; entry++) {
+        expectedHashes_[entry] = hashName(expectedName(entry));
+    }
+    scanIndex_ = 0;
+    scanNumFiles_ = 0;
+    scanFound_ = 0;
+    scanBadFormat_ = false;
+    scanFromCache_ = false;
+    memset(foundIndices_, 0, sizeof(foundIndices_));
+    memset(foundFrames_, 0, sizeof(foundFrames_));
+    cacheValid_ = false;
+    cacheFolderIndex_ = 0;
+    cacheNumFiles_ = 0;
+    cacheUseBank_ = false;
+
+    memset(bankHeader_, 0, sizeof(bankHeader_));
 
-    // Zero the file index mapping
-    memset(fileIndices_, 0, sizeof(fileIndices_));
+    // No instance is driving the loader yet
+    driver_ = nullptr;
+    driverMissedCalls_ = 0;
+    sdWasMounted_ = false;
 }
 
 void SampleManager::reset() {
     // Reset to allow new load attempt
     loadState_ = LoadState::IDLE;
     currentFileIndex_ = 0;
-    callbackPending_ = false;
-    callbackSuccess_ = false;
+    regionFrames_ = 0;
+    regionFramesDone_ = 0;
     retryCount_ = 0;
     retryDelayCounter_ = 0;
 
-    // Re-zero buffers
-    memset(sampleData_, 0, kSampleDataSize * sizeof(int16_t));
-    memset(noiseSample_, 0, kNoiseSampleSize * sizeof(int16_t));
+    // Unload by pointing everything at the silent page. This runs from
+    // step() on unmount, so the sample memory itself is left alone. The
+    // requested bank is then loaded straight into the playing set.
+    for (uint32_t s = 0; s < kNumSets; s++) {
+        releaseSet(sets_[s]);
+    }
+    target_ = active_;
+    sets_[active_].bank = requestedBank_;
+
+    // Cancel the load: no further chunks are issued. A chunk already in
+    // flight still completes into memory nothing points at; its callback is
+    // waited for before the next read so it can't be taken for a new one.
+    if (callbackPending_) {
+        draining_ = true;
+        drainCounter_ = 0;
+    }
+}
+
+void SampleManager::releaseSet(SampleSet& set) {
+    for (uint32_t i = 0; i < kNumWavetables; i++) {
+        evictWavetable(set, i);
+    }
+    set.noiseSample = silentPage_;
+    set.readyMask = 0;
+    // Its slots are free for the wavetables that did not fit
+    deferredMask_ = 0;
+    set.bank = -1;
+    set.useBank = false;
+    set.bankFileIndex = 0;
+    set.bankFrames = 0;
+    memset(set.boundaries, 0, sizeof(set.boundaries));
+}
+
+void SampleManager::evictWavetable(SampleSet& set, uint32_t wavetable) {
+    // A set playing this copy (see allocateSlot()) loses it too
+    if (set.slotOffset[wavetable] != kNoSlot && set.wavetableData[wavetable] != silentPage_) {
+        for (uint32_t s = 0; s < kNumSets; s++) {
+            SampleSet& other = sets_[s];
+            if (&other != &set && other.slotOffset[wavetable] == kNoSlot &&
+                other.wavetableData[wavetable] == set.wavetableData[wavetable]) {
+                evictWavetable(other, wavetable);
+            }
+        }
+    }
+
+    // Unpublish before the slot is reused; step() runs the exciter after
+    // loadStep(), so it never sees a half-overwritten wavetable
+    set.wavetableData[wavetable] = silentPage_;
+    set.wavetableSize[wavetable] = kSilentSamples;
+    set.slotOffset[wavetable] = kNoSlot;
+    set.slotLength[wavetable] = 0;
+    set.readyMask &= static_cast<uint16_t>(~(1u << wavetable));
+}
+
+size_t SampleManager::allocateSlot(uint32_t wavetable, size_t samples) {
+    // Keep slots 16-bit aligned: mu-law reads land two codes per frame
+    samples = (samples + 1) & ~static_cast<size_t>(1);
+    SampleSet& target = sets_[target_];
+
+    for (;;) {
+        // First fit: try the pool start and the end of every slot in use
+        // by either set
+        for (uint32_t candidate = 0; candidate <= kNumSets * kNumWavetables; candidate++) {
+            size_t start = 0;
+            if (candidate < kNumSets * kNumWavetables) {
+                const SampleSet& owner = sets_[candidate / kNumWavetables];
+                const uint32_t slot = candidate % kNumWavetables;
+                if (owner.slotOffset[slot] == kNoSlot) {
+                    continue;
+                }
+                start = owner.slotOffset[slot] + owner.slotLength[slot];
+            }
+            if (start + samples > kWavetablePoolSamples) {
+                continue;
+            }
+
+            bool overlaps = false;
+            for (uint32_t s = 0; s < kNumSets && !overlaps; s++) {
+                const SampleSet& other = sets_[s];
+                for (uint32_t i = 0; i < kNumWavetables; i++) {
+                    if (other.slotOffset[i] != kNoSlot &&
+                        start < other.slotOffset[i] + other.slotLength[i] &&
+                        other.slotOffset[i] < start + samples) {
+                        overlaps = true;
+                        break;
+                    }
+                }
+            }
+            if (!overlaps) {
+                target.slotOffset[wavetable] = start;
+                target.slotLength[wavetable] = samples;
+                return start;
+            }
+        }
+
+        // No room: evict the least recently wanted wavetable of either set,
+        // unwanted ones first. The pool holds three of the largest
+        // wavetables: the two wanted ones plus the one a bank switch stages
+        // (which then hands the playing set its copy). Only wavetables wanted less than this one are evicted, so instances
+        // playing different mallets can't evict each other's wavetables in turn.
+        const int rank = wantRank(wavetable);
+        bool poolEmpty = true;
+        SampleSet* victimSet = nullptr;
+        uint32_t victim = 0;
+        for (uint32_t s = 0; s < kNumSets; s++) {
+            SampleSet& set = sets_[s];
+            for (uint32_t i = 0; i < kNumWavetables; i++) {
+                if ((s == target_ && i == wavetable) || set.slotOffset[i] == kNoSlot) {
+                    continue;
+                }
+                poolEmpty = false;
+                const int iRank = wantRank(i);
+                if (iRank >= rank) {
+                    continue;
+                }
+                if (!victimSet) {
+                    victimSet = &set;
+                    victim = i;
+                    continue;
+                }
+                const int victimRank = wantRank(victim);
+                if (iRank != victimRank ? iRank < victimRank
+                                        : set.lastWanted[i] < victimSet->lastWanted[victim]) {
+                    victimSet = &set;
+                    victim = i;
+                }
+            }
+        }
+        if (poolEmpty) {
+            // Empty pool; wavetable sizes are checked against the slot size
+            target.slotOffset[wavetable] = 0;
+            target.slotLength[wavetable] = samples;
+            return 0;
+        }
+        if (!victimSet) {
+            // Staging a bank: the playing set moves onto the staged copy of
+            // a wavetable both hold, which frees its own slot without a gap
+            if (target_ != active_ && handOverWavetable()) {
+                continue;
+            }
+            return kNoSlot;
+        }
+        evictWavetable(*victimSet, victim);
+    }
 }
 
-int32_t SampleManager::findSampleFolder() const {
+bool SampleManager::handOverWavetable() {
+    SampleSet& playing = sets_[active_];
+    const SampleSet& staged = sets_[target_];
+
+    // The least recently wanted wavetable the staged set has resident
+    uint32_t chosen = kNumWavetables;
+    for (uint32_t i = 0; i < kNumWavetables; i++) {
+        if (playing.slotOffset[i] == kNoSlot || staged.slotOffset[i] == kNoSlot ||
+            !(staged.readyMask & (1u << i))) {
+            continue;
+        }
+        if (chosen == kNumWavetables || playing.lastWanted[i] < playing.lastWanted[chosen]) {
+            chosen = i;
+        }
+    }
+    if (chosen == kNumWavetables) {
+        return false;
+    }
+
+    // Free the playing copy, then play the staged one; it has no slot of
+    // its own, so evicting the staged copy unpublishes it here too
+    evictWavetable(playing, chosen);
+    playing.wavetableData[chosen] = staged.wavetableData[chosen];
+    playing.wavetableSize[chosen] = staged.wavetableSize[chosen];
+    playing.readyMask |= static_cast<uint16_t>(1u << chosen);
+    return true;
+}
+
+int32_t SampleManager::wavetableForStrikeMeta(float meta) {
+    // Elements sweeps the nine sampled mallets over the bottom of the MALLET
+    // range; above it the strike exciter is a mallet/plectrum/particle model
+    if (meta < 0.0f || meta > kSampledMalletMetaMax) {
+        return -1;
+    }
+    // Integral part, like the player's MAKE_INTEGRAL_FRACTIONAL; the loader
+    // keeps the wavetable above it too, which covers a rounding player
+    float position = meta / kSampledMalletMetaMax * static_cast<float>(kNumWavetables - 1);
+    return static_cast<int32_t>(position);
+}
+
+int32_t SampleManager::findSampleFolder(int32_t bank) const {
     if (!NT_isSdCardMounted()) {
         return -1;
     }
 
+    // Bank 0 is the stock folder, user banks add a suffix
+    char name[32];
+    if (bank == 0) {
+        snprintf(name, sizeof(name), "%s", kSampleFolderName);
+    } else {
+        snprintf(name, sizeof(name), "%s_user%d", kSampleFolderName, static_cast<int>(bank));
+    }
+
     uint32_t numFolders = NT_getNumSampleFolders();
 
     for (uint32_t i = 0; i < numFolders; i++) {
         _NT_wavFolderInfo info;
         NT_getSampleFolderInfo(i, info);
 
-        if (info.name && strcmp(info.name, kSampleFolderName) == 0) {
+        if (info.name && strcmp(info.name, name) == 0) {
             return static_cast<int32_t>(i);
         }
     }
@@ -112,105 +358,600 @@ int32_t SampleManager::findSampleFolder() const {
     return -1;  // Folder not found
 }
 
+template <uint32_t kRequest>
 void SampleManager::onSampleLoaded(void* userData, bool success) {
     SampleManager* self = static_cast<SampleManager*>(userData);
+    if (kRequest != self->request_) {
+        return;  // Late callback of an abandoned read
+    }
     self->callbackSuccess_ = success;
     self->callbackPending_ = false;  // Mark callback as received
 }
 
-bool SampleManager::validateFolder(uint32_t folderIndex) {
-    // Check that folder has expected number of files
+void SampleManager::abandonRequest() {
+    if (!callbackPending_) {
+        return;
+    }
+    request_ ^= 1u;
+    callbackPending_ = false;
+    callbackSuccess_ = false;
+}
+
+bool SampleManager::parseBankHeader() {
+    SampleSet& target = sets_[target_];
+
+    // Header values are stored as raw 16-bit words
+    uint16_t words[kBankHeaderFrames];
+    memcpy(words, bankHeader_, sizeof(words));
+
+    if (words[0] != kBankMagic0 || words[1] != kBankMagic1 ||
+        words[2] != kBankVersion || words[3] != kNumWavetables) {
+        return false;
+    }
+
+    // The body must be stored the way this build keeps samples in DRAM
+    if (words[26] != kBankEncoding) {
+        return false;
+    }
+
+    // Boundaries must start at 0, increase, and each wavetable fit a slot
+    size_t boundaries[kNumBoundaries];
+    for (size_t i = 0; i < kNumBoundaries; i++) {
+        boundaries[i] = (static_cast<size_t>(words[4 + i * 2]) << 16) | words[5 + i * 2];
+        if (i == 0 ? boundaries[i] != 0 : boundaries[i] <= boundaries[i - 1]) {
+            return false;
+        }
+        if (i > 0 && boundaries[i] - boundaries[i - 1] > kMaxWavetableSamples) {
+            return false;
+        }
+    }
+
+    // Noise length is fixed by the DSP
+    size_t noiseFrames = (static_cast<size_t>(words[24]) << 16) | words[25];
+    if (noiseFrames != kNoiseSampleSize) {
+        return false;
+    }
+
+    // The file must hold exactly header + regions
+    if (target.bankFrames !=
+        kBankHeaderFrames + framesForSamples(boundaries[kNumWavetables] + noiseFrames)) {
+        return false;
+    }
+
+    memcpy(target.boundaries, boundaries, sizeof(target.boundaries));
+    return true;
+}
+
+bool SampleManager::startRead(uint32_t sample, void* dst, uint32_t startOffset, uint32_t numFrames) {
+    _NT_wavRequest& request = requests_[request_];
+    request.folder = sets_[target_].folderIndex;
+    request.sample = sample;
+    request.dst = dst;
+    request.numFrames = numFrames;
+    request.startOffset = startOffset;
+    request.channels = kNT_WavMono;
+    request.bits = kNT_WavBits16;
+    request.progress = kNT_WavNoProgress;
+    request.callback = request_ == 0 ? &SampleManager::onSampleLoaded<0> :
+                                       &SampleManager::onSampleLoaded<1>;
+    request.callbackData = this;
+
+    callbackPending_ = true;
+    callbackSuccess_ = false;
+
+    if (!NT_readSampleFrames(request)) {
+        callbackPending_ = false;
+        return false;
+    }
+
+    return true;
+}
+
+uint32_t SampleManager::hashName(const char* name) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    while (*name) {
+        hash ^= static_cast<uint8_t>(*name++);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+const char* SampleManager::expectedName(uint32_t entry) {
+    return entry < kNumTotalFiles ? kExpectedFileNames[entry] : kBankFileName;
+}
+
+bool SampleManager::entryFormatOk(uint32_t entry, const _NT_wavInfo& info) {
+    // Everything is mono 16-bit
+    if (info.channels != kNT_WavMono || info.bits != kNT_WavBits16) {
+        return false;
+    }
+    // A bank must hold at least the header and the noise length is fixed by
+    // the DSP; wavetables may be any length that fits a pool slot
+    if (entry == kBankEntry) {
+        return info.numFrames > kBankHeaderFrames;
+    }
+    if (entry == kNoiseRegion) {
+        return info.numFrames == kNoiseSampleSize;
+    }
+    return info.numFrames > 0 && info.numFrames <= kMaxWavetableSamples;
+}
+
+void SampleManager::beginValidation(uint32_t folderIndex) {
     _NT_wavFolderInfo folderInfo;
     NT_getSampleFolderInfo(folderIndex, folderInfo);
-    if (folderInfo.numSampleFiles < kNumTotalFiles) {
-        return false;
+
+    scanNumFiles_ = folderInfo.numSampleFiles;
+    scanIndex_ = 0;
+    scanFound_ = 0;
+    scanBadFormat_ = false;
+
+    // Same folder and file count as the last good validation (e.g. the same
+    // card remounted): only the cached entries are re-checked. A scan
+    // overwrites the cached result.
+    scanFromCache_ = cacheValid_ && cacheFolderIndex_ == folderIndex &&
+        cacheNumFiles_ == scanNumFiles_;
+    if (!scanFromCache_) {
+        cacheValid_ = false;
     }
+}
 
-    // Search for each expected file by name (files may be in any order)
-    for (size_t expectedIdx = 0; expectedIdx < kNumTotalFiles; expectedIdx++) {
-        bool found = false;
+bool SampleManager::checkCachedEntries() {
+    const uint32_t first = cacheUseBank_ ? kBankEntry : 0;
+    const uint32_t last = cacheUseBank_ ? kBankEntry : kNumTotalFiles - 1;
 
-        // Search all files in folder for this expected file name
-        for (uint32_t fileIdx = 0; fileIdx < folderInfo.numSampleFiles; fileIdx++) {
-            _NT_wavInfo fileInfo;
-            NT_getSampleFileInfo(folderIndex, fileIdx, fileInfo);
+    for (uint32_t entry = first; entry <= last; entry++) {
+        _NT_wavInfo fileInfo;
+        NT_getSampleFileInfo(sets_[target_].folderIndex, foundIndices_[entry], fileInfo);
+        if (!fileInfo.name || strcmp(fileInfo.name, expectedName(entry)) != 0 ||
+            !entryFormatOk(entry, fileInfo) || fileInfo.numFrames != foundFrames_[entry]) {
+            return false;
+        }
+    }
 
-            // Check file name matches expected
-            if (!fileInfo.name || strcmp(fileInfo.name, kExpectedFileNames[expectedIdx]) != 0) {
-                continue;  // Not this file, keep searching
-            }
+    return true;
+}
 
-            // Found the file - validate format and size
-            // Validate format: should be mono 16-bit
-            if (fileInfo.channels != kNT_WavMono || fileInfo.bits != kNT_WavBits16) {
-                return false;  // Wrong format
-            }
+void SampleManager::matchEntry(uint32_t fileIdx) {
+    _NT_wavInfo fileInfo;
+    NT_getSampleFileInfo(sets_[target_].folderIndex, fileIdx, fileInfo);
+    if (!fileInfo.name) {
+        return;
+    }
 
-            // Validate frame count matches expected size
-            if (fileInfo.numFrames != kExpectedFrameCounts[expectedIdx]) {
-                return false;  // Wrong size
+    // One hash per folder entry; strcmp only confirms a hash hit
+    const uint32_t hash = hashName(fileInfo.name);
+    for (uint32_t entry = 0; entry < kNumExpectedNames; entry++) {
+        if (hash != expectedHashes_[entry] || (scanFound_ & (1u << entry)) ||
+            strcmp(fileInfo.name, expectedName(entry)) != 0) {
+            continue;
+        }
+
+        if (!entryFormatOk(entry, fileInfo)) {
+            // A bad bank is ignored in favour of the files; a bad file fails
+            if (entry != kBankEntry) {
+                scanBadFormat_ = true;
             }
+            return;
+        }
 
-            // Store the mapping from expected index to actual folder file index
-            fileIndices_[expectedIdx] = fileIdx;
-            found = true;
-            break;
+        foundIndices_[entry] = fileIdx;
+        foundFrames_[entry] = fileInfo.numFrames;
+        scanFound_ |= static_cast<uint16_t>(1u << entry);
+        return;
+    }
+}
+
+int32_t SampleManager::validateStep() {
+    if (scanFromCache_) {
+        scanFromCache_ = false;
+        if (checkCachedEntries()) {
+            adoptValidation();
+            return 1;
         }
+        // The folder changed under the same file count - scan it
+        cacheValid_ = false;
+        return 0;
+    }
+
+    // A bounded number of folder entries per step()
+    uint32_t end = scanIndex_ + kValidateFilesPerStep;
+    if (end > scanNumFiles_) {
+        end = scanNumFiles_;
+    }
+    for (; scanIndex_ < end; scanIndex_++) {
+        matchEntry(scanIndex_);
+    }
+    if (scanIndex_ < scanNumFiles_) {
+        return 0;
+    }
+
+    // Whole folder seen. A packed bank replaces the individual files.
+    const bool useBank = (scanFound_ & (1u << kBankEntry)) != 0;
+    bool valid = useBank;
+#ifndef NT_ELEMENTS_MULAW_SAMPLES
+    // The individual files are 16-bit PCM; mu-law builds need the bank
+    const uint16_t allFiles = static_cast<uint16_t>((1u << kNumTotalFiles) - 1);
+    if (!valid) {
+        valid = !scanBadFormat_ && (scanFound_ & allFiles) == allFiles;
+    }
+#endif
+    if (!valid) {
+        return -1;
+    }
+
+    cacheValid_ = true;
+    cacheFolderIndex_ = sets_[target_].folderIndex;
+    cacheNumFiles_ = scanNumFiles_;
+    cacheUseBank_ = useBank;
+    adoptValidation();
+    return 1;
+}
+
+void SampleManager::adoptValidation() {
+    SampleSet& target = sets_[target_];
+    target.useBank = cacheUseBank_;
 
-        if (!found) {
-            return false;  // Required file not found
+    if (target.useBank) {
+        // Boundaries come from the bank header
+        target.bankFileIndex = foundIndices_[kBankEntry];
+        target.bankFrames = foundFrames_[kBankEntry];
+        return;
+    }
+
+    // Individual files: each wavetable is as long as its file
+    target.boundaries[0] = 0;
+    for (uint32_t i = 0; i < kNumTotalFiles; i++) {
+        target.fileIndices[i] = foundIndices_[i];
+        if (i < kNumWavetables) {
+            target.boundaries[i + 1] = target.boundaries[i] + foundFrames_[i];
         }
     }
+}
+
+int SampleManager::wantRank(uint32_t wavetable) const {
+    // The wavetables under MALLET and the ones above them (see
+    // wavetableForStrikeMeta), over every instance
+    if (wavetable >= kNumWavetables) {
+        return 0;
+    }
+    const uint32_t bit = 1u << wavetable;
+    if (preferredMask_ & bit) {
+        return 2;
+    }
+    return (preferredMask_ << 1) & bit ? 1 : 0;
+}
 
-    return true;
+bool SampleManager::isWanted(uint32_t wavetable) const {
+    return wantRank(wavetable) > 0;
+}
+
+uint32_t SampleManager::selectNextFile() const {
+    const SampleSet& target = sets_[target_];
+    const bool staging = target_ != active_;
+
+    // The wavetables under MALLET, then the noise the granular player needs,
+    // then the wavetables above them (after the swap when staging a bank).
+    // Anything else is loaded only on demand, and wavetables that did not
+    // fit in the pool wait until the wanted set changes.
+    const uint32_t missing = ~(static_cast<uint32_t>(target.readyMask) | deferredMask_);
+    const uint32_t preferred = preferredMask_ & missing;
+    if (preferred) {
+        return static_cast<uint32_t>(__builtin_ctz(preferred));
+    }
+    if (!(target.readyMask & (1u << kNoiseRegion))) {
+        return kNoiseRegion;
+    }
+    const uint32_t above = (preferredMask_ << 1) & ~preferredMask_ & missing &
+                           ((1u << kNumWavetables) - 1);
+    if (!staging && above) {
+        return static_cast<uint32_t>(__builtin_ctz(above));
+    }
+
+    return kNumTotalFiles;  // Everything wanted is resident
+}
+
+bool SampleManager::beginNextRegion() {
+    currentFileIndex_ = selectNextFile();
+
+    // A staged bank has every wavetable under MALLET and the noise: swap it
+    // in (step() re-reads the accessors after loadStep()) and release the
+    // old one. One that didn't fit keeps the old bank playing until the
+    // wanted set changes.
+    const uint32_t needed = preferredMask_ | (1u << kNoiseRegion);
+    if (currentFileIndex_ >= kNumTotalFiles && target_ != active_ &&
+        (sets_[target_].readyMask & needed) == needed) {
+        const uint32_t old = active_;
+        active_ = target_;
+        releaseSet(sets_[old]);
+        currentFileIndex_ = selectNextFile();
+    }
+
+    if (currentFileIndex_ >= kNumTotalFiles) {
+        // Everything the patch can reach is resident
+        loadState_ = LoadState::COMPLETE;
+        return true;
+    }
+
+    loadState_ = (currentFileIndex_ < kNumWavetables)
+        ? LoadState::LOADING_WAVETABLE : LoadState::LOADING_NOISE;
+    return startNextLoad();
 }
 
 bool SampleManager::startNextLoad() {
-    // Determine destination buffer and size based on current file index
-    void* destBuffer;
-    uint32_t numFrames;
+    SampleSet& target = sets_[target_];
 
+    // Region position in the source: a bank holds every region after its
+    // header, the individual files hold one region each
+    size_t sourceStart = 0;
+    size_t samples = kNoiseSampleSize;
     if (currentFileIndex_ < kNumWavetables) {
-        // Loading a wavetable
-        size_t startOffset = boundaries_[currentFileIndex_];
-        destBuffer = sampleData_ + startOffset;
-        numFrames = static_cast<uint32_t>(boundaries_[currentFileIndex_ + 1] - startOffset);
+        sourceStart = target.boundaries[currentFileIndex_];
+        samples = target.boundaries[currentFileIndex_ + 1] - sourceStart;
     } else {
-        // Loading noise sample (index 9)
-        destBuffer = noiseSample_;
-        numFrames = static_cast<uint32_t>(kNoiseSampleSize);
-    }
-
-    // Set up the persistent request structure
-    // Use the file index mapping to get actual folder file index
-    currentRequest_.folder = folderIndex_;
-    currentRequest_.sample = fileIndices_[currentFileIndex_];
-    currentRequest_.dst = destBuffer;
-    currentRequest_.numFrames = numFrames;
-    currentRequest_.startOffset = 0;
-    currentRequest_.channels = kNT_WavMono;
-    currentRequest_.bits = kNT_WavBits16;
-    currentRequest_.progress = kNT_WavNoProgress;
-    currentRequest_.callback = &SampleManager::onSampleLoaded;
-    currentRequest_.callbackData = this;
-
-    // Mark that we're waiting for callback
-    callbackPending_ = true;
-    callbackSuccess_ = false;
+        sourceStart = target.boundaries[kNumWavetables];
+    }
 
-    // Initiate the read
-    if (!NT_readSampleFrames(currentRequest_)) {
-        callbackPending_ = false;
-        return false;
+    // Mu-law regions can start halfway through a 16-bit frame; the read
+    // then starts one code early and the lead is skipped when publishing
+    regionSource_ = target.fileIndices[currentFileIndex_];
+    regionStartFrame_ = 0;
+    currentLead_ = 0;
+    if (target.useBank) {
+        const size_t byteStart = sourceStart * sizeof(Sample);
+        regionSource_ = target.bankFileIndex;
+        regionStartFrame_ = kBankHeaderFrames + static_cast<uint32_t>(byteStart / 2);
+        currentLead_ = (byteStart & 1) / sizeof(Sample);
     }
+    regionFrames_ = framesForSamples(currentLead_ + samples);
+    regionFramesDone_ = 0;
+    chunkRetries_ = 0;
+    regionSamples_ = samples;
 
-    return true;
+    if (currentFileIndex_ < kNumWavetables) {
+#ifdef NT_ELEMENTS_RESAMPLE_SAMPLES
+        // The slot holds the wavetable at the host rate; it is read into the
+        // start of the slot and resampled in place
+        resampleSource_ = samples;
+        regionSamples_ = resampledLength(samples, preparedStep_);
+#endif
+        // A wavetable: make room in the pool (it is not published until read)
+        evictWavetable(target, currentFileIndex_);
+        size_t offset = allocateSlot(currentFileIndex_, regionSamples_ + kSlotSlack);
+        if (offset == kNoSlot) {
+            // Every slot holds a wavetable wanted as much: skip this one
+            deferredMask_ |= static_cast<uint16_t>(1u << currentFileIndex_);
+            return beginNextRegion();
+        }
+        regionDst_ = reinterpret_cast<uint8_t*>(pool_ + offset);
+    } else {
+        // Loading noise sample (index 9); silent until the read completes
+        target.noiseSample = silentPage_;
+        target.readyMask &= static_cast<uint16_t>(~(1u << kNoiseRegion));
+        regionDst_ = reinterpret_cast<uint8_t*>(target.noiseBuffer);
+    }
+
+    return startNextChunk();
+}
+
+bool SampleManager::startNextChunk() {
+    // Frames are 16-bit, so the destination advances two bytes per frame
+    uint32_t remaining = regionFrames_ - regionFramesDone_;
+    chunkFrames_ = remaining < kChunkFrames ? remaining : kChunkFrames;
+    return startRead(regionSource_, regionDst_ + regionFramesDone_ * 2,
+                     regionStartFrame_ + regionFramesDone_, chunkFrames_);
+}
+
+uint32_t SampleManager::getLoadProgress() const {
+#ifdef NT_ELEMENTS_RESAMPLE_SAMPLES
+    if (loadState_ == LoadState::RESAMPLING && regionSamples_ > 0) {
+        return static_cast<uint32_t>((regionSamples_ - resampleRemaining_) * 100 / regionSamples_);
+    }
+#endif
+    if (regionFrames_ == 0) {
+        return 0;
+    }
+    return regionFramesDone_ * 100 / regionFrames_;
 }
 
-bool SampleManager::loadStep() {
-    // Already complete?
+void SampleManager::publishRegion() {
+    SampleSet& target = sets_[target_];
+
+    // The sample after the end is silenced (nothing else was cleared) for
+    // the player's interpolation
+    if (currentFileIndex_ < kNumWavetables) {
+        Sample* data = pool_ + target.slotOffset[currentFileIndex_] + currentLead_;
+        data[regionSamples_] = static_cast<Sample>(kSilenceByte);
+        target.wavetableData[currentFileIndex_] = data;
+        target.wavetableSize[currentFileIndex_] = regionSamples_;
+    } else {
+        target.noiseBuffer[currentLead_ + kNoiseSampleSize] = static_cast<Sample>(kSilenceByte);
+        target.noiseSample = target.noiseBuffer + currentLead_;
+    }
+    target.readyMask |= static_cast<uint16_t>(1u << currentFileIndex_);
+}
+
+#ifdef NT_ELEMENTS_RESAMPLE_SAMPLES
+uint32_t SampleManager::hostRateStep() {
+    uint32_t rate = NT_globals.sampleRate;
+    if (rate <= kSourceSampleRate) {
+        return 0;   // Only upsampling is done in place
+    }
+    if (rate > kMaxResampleRate) {
+        rate = kMaxResampleRate;
+    }
+    return static_cast<uint32_t>((static_cast<uint64_t>(kSourceSampleRate) << 16) / rate);
+}
+
+size_t SampleManager::resampledLength(size_t samples, uint32_t step) {
+    if (step == 0 || samples < 2) {
+        return samples;
+    }
+    // Last output lands on or before the last source sample
+    return static_cast<size_t>((static_cast<uint64_t>(samples - 1) << 16) / step) + 1;
+}
+
+bool SampleManager::resampleBlock() {
+    Sample* data = pool_ + sets_[target_].slotOffset[currentFileIndex_] + currentLead_;
+
+    // Linear interpolation, back to front: output j reads source samples at
+    // or before j, which haven't been overwritten yet
+    size_t count = resampleRemaining_ < kResampleSamplesPerStep
+        ? resampleRemaining_ : kResampleSamplesPerStep;
+    for (; count > 0; --count) {
+        const size_t j = --resampleRemaining_;
+        const uint64_t position = static_cast<uint64_t>(j) * preparedStep_;
+        const size_t i = static_cast<size_t>(position >> 16);
+        const int32_t fractional = static_cast<int32_t>((position & 0xFFFF) >> 1);
+        const int32_t a = decodeSample(data[i]);
+        int32_t value = a;
+        if (fractional && i + 1 < resampleSource_) {
+            value += ((decodeSample(data[i + 1]) - a) * fractional) >> 15;
+        }
+        data[j] = encodeSample(value);
+    }
+
+    return resampleRemaining_ == 0;
+}
+
+void SampleManager::checkHostRate() {
+    // Wait for a wavetable in flight; it finishes at the old rate and is
+    // dropped on the next call
+    if (loadState_ == LoadState::LOADING_WAVETABLE || loadState_ == LoadState::RESAMPLING) {
+        return;
+    }
+
+    const uint32_t step = hostRateStep();
+    if (step == preparedStep_) {
+        return;
+    }
+
+    // Unload every wavetable (a pointer swap); the wanted ones reload at
+    // the new rate
+    for (uint32_t s = 0; s < kNumSets; s++) {
+        for (uint32_t i = 0; i < kNumWavetables; i++) {
+            evictWavetable(sets_[s], i);
+        }
+    }
+    preparedStep_ = step;
+}
+#endif
+
+void SampleManager::beginBankSwitch() {
+    // Any bank being staged is dropped (a region half-read for it too)
+    if (target_ != active_) {
+        releaseSet(sets_[target_]);
+        target_ = active_;
+    }
+
+    // Switching back to the playing bank: nothing to load
+    if (requestedBank_ == sets_[active_].bank) {
+        loadState_ = LoadState::COMPLETE;
+        return;
+    }
+
+    // Stage into the idle set while the playing set has data; otherwise
+    // there is nothing to keep playing and the playing set is reloaded
+    if (sets_[active_].readyMask != 0) {
+        target_ = active_ ^ 1u;
+    }
+    releaseSet(sets_[target_]);
+    sets_[target_].bank = requestedBank_;
+
+    loadState_ = LoadState::IDLE;
+    regionFrames_ = 0;
+    regionFramesDone_ = 0;
+    retryCount_ = 0;
+    retryDelayCounter_ = 0;
+}
+
+void SampleManager::failLoad() {
+    loadState_ = LoadState::FAILED;
+    retryDelayCounter_ = kRetryDelayFrames;
+    ++retryCount_;
+}
+
+bool SampleManager::loadStep(const void* client) {
+    // Every instance calls this from its step(); only the driver advances the
+    // state machine so retry delays and SD reads aren't multiplied by the
+    // number of instances. A driver that stops calling has been removed.
+    if (client != driver_) {
+        if (driver_ && ++driverMissedCalls_ < kDriverTimeoutCalls) {
+            return isLoaded();
+        }
+        driver_ = client;
+    }
+    driverMissedCalls_ = 0;
+
+    // Every instance has reported its wavetable since the last driver pass
+    if (reportedMask_ != preferredMask_) {
+        preferredMask_ = reportedMask_;
+        deferredMask_ = 0;
+        ++tick_;
+    }
+    reportedMask_ = 0;
+
+    // Per distingNT API: "All built-in algorithms watch for card (un)mount in step()"
+    bool mounted = NT_isSdCardMounted();
+    if (!mounted && sdWasMounted_) {
+        // SD card just unmounted - reset for potential reload
+        reset();
+    } else if (mounted && !sdWasMounted_) {
+        // SD card (re)mounted: a read from the old mount won't complete, and
+        // a load given up on then starts afresh
+        abandonRequest();
+        draining_ = false;
+        drainCounter_ = 0;
+        reset();
+    }
+    sdWasMounted_ = mounted;
+
+    return advance();
+}
+
+bool SampleManager::advance() {
+    // Stamp the wanted wavetables of both sets for LRU eviction
+    for (uint32_t i = 0; i < kNumWavetables; i++) {
+        if (isWanted(i)) {
+            for (uint32_t s = 0; s < kNumSets; s++) {
+                sets_[s].lastWanted[i] = tick_;
+            }
+        }
+    }
+
+    // After a cancel, wait for the chunk that was in flight. Until its
+    // callback arrives the host still owns its request and may write the
+    // old destination, so no new read can start. A callback that hasn't
+    // arrived after the retry delay is not coming: the request is left to
+    // the host and loading carries on with the other one.
+    if (draining_) {
+        if (callbackPending_ && ++drainCounter_ < kRetryDelayFrames) {
+            return false;
+        }
+        abandonRequest();
+        draining_ = false;
+    }
+
+    // A different sample bank was selected: start on it between chunks
+    if (requestedBank_ != sets_[target_].bank && !callbackPending_) {
+        beginBankSwitch();
+    }
+
+#ifdef NT_ELEMENTS_RESAMPLE_SAMPLES
+    checkHostRate();
+#endif
+
+    SampleSet& target = sets_[target_];
+
+    // Complete until MALLET moves onto a wavetable that isn't resident
     if (loadState_ == LoadState::COMPLETE) {
-        return true;
+        if (selectNextFile() >= kNumTotalFiles) {
+            return true;
+        }
+        if (!beginNextRegion()) {
+            failLoad();
+        }
+        return false;
     }
 
     // SD card not mounted?
@@ -225,6 +966,14 @@ bool SampleManager::loadStep() {
     // Handle retry delay
     if (loadState_ == LoadState::FAILED) {
         if (retryCount_ >= kMaxRetries) {
+            // A bank that can't be staged is given up; the playing one stays
+            if (target_ != active_) {
+                releaseSet(target);
+                target_ = active_;
+                requestedBank_ = sets_[active_].bank;
+                retryCount_ = 0;
+                loadState_ = LoadState::COMPLETE;
+            }
             // Max retries exceeded, stay in FAILED state
             return false;
         }
@@ -239,96 +988,142 @@ bool SampleManager::loadStep() {
     // State machine
     switch (loadState_) {
         case LoadState::IDLE: {
-            // Find the elements folder
-            int32_t folder = findSampleFolder();
+            // Find the sample folder of the bank being loaded
+            int32_t folder = findSampleFolder(target.bank);
             if (folder < 0) {
                 // Folder not found - go to failed with retry
-                loadState_ = LoadState::FAILED;
-                retryDelayCounter_ = kRetryDelayFrames;
-                ++retryCount_;
+                failLoad();
                 return false;
             }
-            folderIndex_ = static_cast<uint32_t>(folder);
+            target.folderIndex = static_cast<uint32_t>(folder);
+            beginValidation(target.folderIndex);
             loadState_ = LoadState::VALIDATING;
             return false;
         }
 
         case LoadState::VALIDATING: {
-            // Validate folder contents (quick synchronous check)
-            if (!validateFolder(folderIndex_)) {
-                loadState_ = LoadState::FAILED;
-                retryDelayCounter_ = kRetryDelayFrames;
-                ++retryCount_;
+            // Validate folder contents a few entries per step()
+            int32_t result = validateStep();
+            if (result == 0) {
                 return false;
             }
-            // Start loading first wavetable
-            currentFileIndex_ = 0;
-            loadState_ = LoadState::LOADING_WAVETABLE;
-            if (!startNextLoad()) {
-                loadState_ = LoadState::FAILED;
-                retryDelayCounter_ = kRetryDelayFrames;
-                ++retryCount_;
+            if (result < 0) {
+                failLoad();
                 return false;
             }
-            return false;
+            // Packed bank: read its header first
+            if (target.useBank) {
+                loadState_ = LoadState::LOADING_BANK_INDEX;
+                if (!startRead(target.bankFileIndex, bankHeader_, 0, kBankHeaderFrames)) {
+                    failLoad();
+                }
+                return false;
+            }
+
+            // Start loading the most wanted region (regions that are
+            // already ready from an earlier attempt are skipped)
+            if (!beginNextRegion()) {
+                failLoad();
+                return false;
+            }
+            return isLoaded();
         }
 
-        case LoadState::LOADING_WAVETABLE: {
+        case LoadState::LOADING_WAVETABLE:
+        case LoadState::LOADING_NOISE: {
             // Check if we're waiting for callback
             if (callbackPending_) {
                 return false;  // Still waiting
             }
 
-            // Callback received - check result
+            // Callback received - a failed chunk is re-read on its own
+            // before the whole load is given up
             if (!callbackSuccess_) {
-                // This wavetable failed to load
-                loadState_ = LoadState::FAILED;
-                retryDelayCounter_ = kRetryDelayFrames;
-                ++retryCount_;
+                if (++chunkRetries_ > kMaxChunkRetries || !startNextChunk()) {
+                    failLoad();
+                }
                 return false;
             }
+            chunkRetries_ = 0;
+            regionFramesDone_ += chunkFrames_;
 
-            // Move to next file
-            ++currentFileIndex_;
-
-            if (currentFileIndex_ < kNumWavetables) {
-                // More wavetables to load
-                if (!startNextLoad()) {
-                    loadState_ = LoadState::FAILED;
-                    retryDelayCounter_ = kRetryDelayFrames;
-                    ++retryCount_;
+            // A wavetable MALLET has moved away from is abandoned between
+            // chunks; the next wanted region starts right away
+            if (currentFileIndex_ < kNumWavetables && !isWanted(currentFileIndex_)) {
+                evictWavetable(target, currentFileIndex_);
+                if (!beginNextRegion()) {
+                    failLoad();
                     return false;
                 }
-            } else {
-                // All wavetables done, load noise
-                loadState_ = LoadState::LOADING_NOISE;
-                if (!startNextLoad()) {
-                    loadState_ = LoadState::FAILED;
-                    retryDelayCounter_ = kRetryDelayFrames;
-                    ++retryCount_;
-                    return false;
+                return isLoaded();
+            }
+
+            // More of this region to read?
+            if (regionFramesDone_ < regionFrames_) {
+                if (!startNextChunk()) {
+                    failLoad();
                 }
+                return false;
             }
-            return false;
+
+#ifdef NT_ELEMENTS_RESAMPLE_SAMPLES
+            // Convert the wavetable to the host rate before publishing it
+            if (currentFileIndex_ < kNumWavetables && regionSamples_ != resampleSource_) {
+                resampleRemaining_ = regionSamples_;
+                loadState_ = LoadState::RESAMPLING;
+                return false;
+            }
+#endif
+
+            // Publish the region; it is playable now, without waiting for the rest
+            publishRegion();
+
+            // Move to the next region by priority
+            if (!beginNextRegion()) {
+                failLoad();
+                return false;
+            }
+            return isLoaded();
         }
 
-        case LoadState::LOADING_NOISE: {
-            // Check if we're waiting for callback
+#ifdef NT_ELEMENTS_RESAMPLE_SAMPLES
+        case LoadState::RESAMPLING: {
+            // Abandoned like a read if MALLET moves away
+            if (!isWanted(currentFileIndex_)) {
+                evictWavetable(target, currentFileIndex_);
+            } else if (!resampleBlock()) {
+                return false;
+            } else {
+                publishRegion();
+            }
+
+            if (!beginNextRegion()) {
+                failLoad();
+                return false;
+            }
+            return isLoaded();
+        }
+#else
+        case LoadState::RESAMPLING:
+            return false;
+#endif
+
+        case LoadState::LOADING_BANK_INDEX: {
             if (callbackPending_) {
                 return false;  // Still waiting
             }
 
-            // Callback received - check result
-            if (!callbackSuccess_) {
-                loadState_ = LoadState::FAILED;
-                retryDelayCounter_ = kRetryDelayFrames;
-                ++retryCount_;
+            if (!callbackSuccess_ || !parseBankHeader()) {
+                failLoad();
                 return false;
             }
 
-            // All files loaded successfully!
-            loadState_ = LoadState::COMPLETE;
-            return true;
+            // Regions are read from the bank by offset, on demand
+            if (!beginNextRegion()) {
+                failLoad();
+                return false;
+            }
+            return isLoaded();
         }
 
         case LoadState::COMPLETE:
@@ -15,101 +15,309 @@
  * the disting NT's SD card. It allocates DRAM for sample storage and provides
  * accessors for the Elements DSP code.
  *
+ * A single SampleManager and its sample data live in the plugin's static
+ * DRAM and are shared by every nt_elements instance, so the samples are read
+ * from the card once no matter how many instances are running.
+ *
+ * Samples come either from one file per region (wavetable_00.wav ...
+ * noise.wav) or from a single packed bank.wav produced by
+ * scripts/extract_samples.py. The bank starts with a kBankHeaderFrames
+ * index (magic, version, region boundaries, noise length) followed by all
+ * regions back to back, so each region is read from the open bank by
+ * offset. With individual files the boundaries come from the file lengths,
+ * so a user set may use its own wavetable sizes.
+ *
+ * Sample banks: bank 0 is the "elements" folder, bank N the
+ * "elements_userN" folder. One bank (setSampleBank()) is played by every
+ * instance. Each bank is loaded into one of two sample sets. Switching
+ * banks loads the new bank into the other set while the current one keeps
+ * playing, then swaps the set the exciter reads at the next step() and
+ * releases the old one.
+ *
+ * Wavetables are loaded on demand. Only the wavetables under the MALLET
+ * settings of the running instances and the ones above them are read, into
+ * a slot pool shared by both sets. When the pool is full the least recently
+ * wanted wavetable is evicted, but never for one wanted less. Patches that
+ * never reach the sampled mallets only load the noise sample. A bank switch
+ * swaps in once the new set has every wavetable under MALLET and the
+ * noise; the ones above follow after the swap. If the pool can't hold a
+ * wavetable under MALLET in both sets, the playing set switches to the new
+ * set's copy of one it already holds to make room, so no wavetable goes
+ * silent on the way.
+ *
+ * Nothing is zeroed after init(). Regions that aren't resident (not loaded
+ * yet, being overwritten, or dropped by reset() on unmount) point at a
+ * silent page that is filled once in init(), so unloading is a pointer swap
+ * and never touches the sample memory from step().
+ *
  * Memory layout in DRAM:
- *   - sampleData_[0..128012]  (256,026 bytes) - 9 wavetables concatenated
- *   - noiseSample_[0..40962]  (81,926 bytes)  - Noise sample
+ *   - pool_[0..98309]            (196,620 bytes) - Wavetable slots (x3 resampling)
+ *   - noise buffers 2x[0..40964] (163,860 bytes) - Noise sample per set
+ *   - silentPage_[0..40964]      (81,930 bytes)  - Silence (shared stand-in)
+ *
+ * Builds with NT_ELEMENTS_MULAW_SAMPLES (make SAMPLE_STORAGE=mulaw) keep
+ * each sample as one 8-bit mu-law code instead (~216KB in total), decoded
+ * by the exciter on read. They load only a mu-law bank.wav produced by
+ * scripts/compress_samples.py; the individual PCM files are not accepted.
+ *
+ * The wavetables hold Elements' original 32kHz data (whatever rate the
+ * files are tagged with), and the exciter plays one sample per frame, so
+ * at 48kHz they play back 1.5x fast. Builds with
+ * NT_ELEMENTS_RESAMPLE_SAMPLES (make SAMPLE_RESAMPLE=on) resample each
+ * wavetable in place to the host rate after it is read, a block of
+ * kResampleSamplesPerStep samples per step(), before publishing it. Slots
+ * are sized for 96kHz (pool ~590KB, ~295KB mu-law), and a rate change
+ * reloads the resident wavetables. The noise sample is left at the source
+ * rate (its length is fixed by the granular player). The boundaries keep
+ * describing the source files; getWavetableSizes() gives the resampled
+ * lengths.
  *
  * Usage:
- *   1. Add SampleManager::kTotalDramBytes to DRAM requirements
- *   2. Call init() with DRAM pointer in construct()
- *   3. Call loadStep() from step() when SD card is mounted
- *   4. Use accessors to get pointers for Elements DSP (zeros if not loaded)
+ *   1. Add SampleManager::kTotalDramBytes to the static DRAM requirements
+ *   2. Call init() with DRAM pointer in initialise()
+ *   3. Call setPreferredWavetable() and loadStep() from every instance's step()
+ *   4. Re-read the accessors after loadStep() (they change on a bank swap)
  *
  * Loading is non-blocking - call loadStep() each frame and it will
- * incrementally load files one at a time without blocking the audio thread.
+ * incrementally load regions one kChunkFrames chunk at a time without
+ * blocking the audio thread. An unmount cancels the load between chunks.
+ * Only one instance (the driver) advances the state machine; if the driver
+ * stops calling (the instance was removed) another instance takes over.
  */
 class SampleManager {
 public:
-    // Memory size constants
-    static constexpr size_t kSampleDataSize = 128013;   // int16_t samples (9 wavetables)
-    static constexpr size_t kNoiseSampleSize = 40963;   // int16_t samples (noise)
-    static constexpr size_t kTotalSamples = kSampleDataSize + kNoiseSampleSize;
-    static constexpr size_t kTotalDramBytes = kTotalSamples * sizeof(int16_t);  // ~338KB
+    // Stored sample type (matches elements::SampleStorage)
+#ifdef NT_ELEMENTS_MULAW_SAMPLES
+    typedef uint8_t Sample;     // G.711 mu-law code
+    static constexpr int kSilenceByte = 0xFF;   // mu-law code for 0
+#else
+    typedef int16_t Sample;     // 16-bit PCM
+    static constexpr int kSilenceByte = 0;
+#endif
 
     // Number of wavetables and boundary entries
     static constexpr size_t kNumWavetables = 9;
     static constexpr size_t kNumBoundaries = kNumWavetables + 1;
     static constexpr size_t kNumTotalFiles = kNumWavetables + 1;  // 9 wavetables + 1 noise
 
-    // Sample folder name on SD card
+    // Memory size constants
+    static constexpr size_t kNoiseSampleSize = 40963;   // Samples (noise, fixed by the DSP)
+    static constexpr size_t kMaxWavetableSamples = 32768;   // Largest wavetable (stock: 32681)
+    static constexpr size_t kSlotSlack = 2;     // Unaligned bank reads round up a frame
+    static constexpr size_t kPoolSlots = 3;     // Two wanted wavetables + one staged
+#ifdef NT_ELEMENTS_RESAMPLE_SAMPLES
+    static constexpr uint32_t kSourceSampleRate = 32000;    // Rate of the Elements data
+    static constexpr uint32_t kMaxResampleRate = 96000;     // Slots are sized for this rate
+    static constexpr size_t kMaxResampleRatio = kMaxResampleRate / kSourceSampleRate;
+    static constexpr size_t kResampleSamplesPerStep = 1024;
+#else
+    static constexpr size_t kMaxResampleRatio = 1;
+#endif
+    static constexpr size_t kSlotSamples = kMaxWavetableSamples * kMaxResampleRatio + kSlotSlack;
+    static constexpr size_t kWavetablePoolSamples = kPoolSlots * kSlotSamples;
+    static constexpr size_t kSilentSamples = 16;        // Played while a wavetable is missing
+    static constexpr size_t kNoiseBufferSamples = kNoiseSampleSize + kSlotSlack;
+    static constexpr size_t kSilentPageSamples = kNoiseBufferSamples;  // Covers any region
+    static constexpr size_t kNumSets = 2;       // Playing set + bank being swapped in
+    static constexpr size_t kTotalSamples =
+        kWavetablePoolSamples + kNumSets * kNoiseBufferSamples + kSilentPageSamples;
+    static constexpr size_t kTotalDramBytes =
+        (kTotalSamples * sizeof(Sample) + 1) & ~static_cast<size_t>(1);  // ~432KB (~216KB mu-law), ~836KB resampling
+
+    // Sample folders on SD card: bank 0 uses kSampleFolderName, bank N
+    // kSampleFolderName + "_userN"
     static constexpr const char* kSampleFolderName = "elements";
+    static constexpr int32_t kNumSampleBanks = 4;
+
+    // Packed sample bank (preferred over the individual files when present)
+    // Header frames (int16): [0..1] magic "ELBK", [2] version, [3] wavetable
+    // count, [4..23] boundaries as (high, low) 16-bit pairs, [24..25] noise
+    // frames as (high, low), [26] encoding, rest zero
+    static constexpr const char* kBankFileName = "bank.wav";
+    static constexpr uint32_t kBankHeaderFrames = 32;
+    static constexpr uint16_t kBankMagic0 = 0x454C;   // "EL"
+    static constexpr uint16_t kBankMagic1 = 0x424B;   // "BK"
+    static constexpr uint16_t kBankVersion = 1;
+
+    // Bank body encoding (header word 26)
+    static constexpr uint16_t kBankEncodingPcm16 = 0;
+    static constexpr uint16_t kBankEncodingMuLaw = 1;   // Two codes per 16-bit frame
+#ifdef NT_ELEMENTS_MULAW_SAMPLES
+    static constexpr uint16_t kBankEncoding = kBankEncodingMuLaw;
+#else
+    static constexpr uint16_t kBankEncoding = kBankEncodingPcm16;
+#endif
+
+    // Regions are read in chunks of this many frames, so a load can be
+    // cancelled or resumed between chunks and doesn't hold the card for long
+    static constexpr uint32_t kChunkFrames = 4096;
+    static constexpr uint32_t kMaxChunkRetries = 2;     // Re-reads of a failed chunk
 
     // Retry settings for failed loads
     static constexpr uint32_t kRetryDelayFrames = 48000;  // ~1 second at 48kHz step rate
     static constexpr uint32_t kMaxRetries = 3;
 
+    // Folder entries examined per step() while validating
+    static constexpr uint32_t kValidateFilesPerStep = 4;
+
+    // Calls from other instances before a silent driver is replaced
+    static constexpr uint32_t kDriverTimeoutCalls = 64;
+
+    // Region index of the noise sample (wavetables are regions 0-8)
+    static constexpr uint32_t kNoiseRegion = kNumWavetables;
+
+    // Strike META (MALLET) range played by the sampled mallets
+    static constexpr float kSampledMalletMetaMax = 0.4f;
+
     // Loading state machine
     enum class LoadState : uint8_t {
         IDLE,               // Not loading, ready to start or already complete
-        VALIDATING,         // Validating folder contents before loading
+        VALIDATING,         // Scanning folder contents before loading
         LOADING_WAVETABLE,  // Currently loading a wavetable (index in currentFileIndex_)
         LOADING_NOISE,      // Currently loading the noise sample
-        COMPLETE,           // All files loaded successfully
+        RESAMPLING,         // Converting the loaded wavetable to the host rate
+        LOADING_BANK_INDEX, // Reading the packed bank header
+        COMPLETE,           // Everything the current patch can reach is resident
         FAILED              // Loading failed, can retry
     };
 
     /**
      * Initialize the sample manager with a DRAM buffer.
-     * Zeros all memory and sets up internal pointers.
+     * Fills the silent page and sets up internal pointers.
      *
      * @param dramBuffer Pointer to DRAM buffer of at least kTotalDramBytes
      */
-    void init(int16_t* dramBuffer);
+    void init(Sample* dramBuffer);
 
     /**
      * Non-blocking step function - call from step() each frame.
-     * Manages the async loading state machine.
-     * Does nothing if already loaded or SD card not mounted.
+     * Manages the async loading state machine and SD card (un)mounts.
+     * Does nothing if everything wanted is resident or SD card not mounted.
      *
+     * @param client Identifies the calling instance (its algorithm pointer)
      * @return true if samples are ready (loaded or already loaded)
      */
-    bool loadStep();
+    bool loadStep(const void* client);
+
+    /**
+     * Select the sample bank every instance plays. The current bank keeps
+     * playing until the new one is ready; a bank that can't be loaded is
+     * given up and getSampleBank() returns to the playing one.
+     *
+     * @param bank 0 = "elements", 1..kNumSampleBanks-1 = "elements_userN"
+     */
+    void setSampleBank(int32_t bank) {
+        if (bank >= 0 && bank < kNumSampleBanks) {
+            requestedBank_ = bank;
+        }
+    }
+
+    /**
+     * Get the sample bank selected for every instance (playing, or being
+     * loaded to replace the playing one).
+     */
+    int32_t getSampleBank() const { return requestedBank_; }
 
     /**
      * Reset loading state to allow retry.
-     * Call this when SD card is unmounted or to force reload.
+     * Called on SD card unmount and mount, or to force reload. Points every
+     * region at the silent page; no sample memory is cleared.
      */
     void reset();
 
     /**
-     * Get pointer to wavetable sample data.
-     * Contains all 9 wavetables concatenated.
+     * Get pointer to the wavetable slot pool.
+     * Wavetables are reached through getWavetableData(), not by offset.
+     *
+     * @return Pointer to the pool
+     */
+    const Sample* getSampleData() const { return pool_; }
+
+    /**
+     * Get pointer to noise sample data of the playing set.
      *
-     * @return Pointer to sample data (zeros if not loaded)
+     * @return Pointer to noise sample (the silent page if not loaded). Moves
+     *         on a bank swap and when a mu-law bank stores the noise at an
+     *         odd offset.
      */
-    const int16_t* getSampleData() const { return sampleData_; }
+    const Sample* getNoiseSample() const { return sets_[active_].noiseSample; }
 
     /**
-     * Get pointer to noise sample data.
+     * Get the per-wavetable data pointers read by the exciter.
+     * Wavetables that are not resident point at the silent page.
      *
-     * @return Pointer to noise sample (zeros if not loaded)
+     * @return Array of kNumWavetables pointers (changes on a bank swap)
      */
-    const int16_t* getNoiseSample() const { return noiseSample_; }
+    const Sample* const* getWavetableData() const { return sets_[active_].wavetableData; }
 
     /**
-     * Get pointer to wavetable boundaries array.
-     * Contains 10 values: start offsets for each of 9 wavetables plus end offset.
+     * Get the per-wavetable lengths matching getWavetableData().
      *
-     * @return Pointer to boundaries array
+     * @return Array of kNumWavetables sample counts (changes on a bank swap)
      */
-    const size_t* getBoundaries() const { return boundaries_; }
+    const size_t* getWavetableSizes() const { return sets_[active_].wavetableSize; }
+
+    /**
+     * Get pointer to wavetable boundaries array of the playing set.
+     * Contains 10 values: start offsets for each of 9 wavetables plus end
+     * offset, as laid out in the source files.
+     *
+     * @return Pointer to boundaries array (changes on a bank swap)
+     */
+    const size_t* getBoundaries() const { return sets_[active_].boundaries; }
 
     /**
      * Check if samples have been loaded.
      *
-     * @return true if samples are loaded, false otherwise
+     * @return true if everything the current patch can reach is resident
+     *         and no bank switch is in progress
+     */
+    bool isLoaded() const { return loadState_ == LoadState::COMPLETE && target_ == active_; }
+
+    /**
+     * Check if a single region of the playing set is resident. Regions
+     * become playable as soon as their data is read, and wavetables stop
+     * being ready when evicted.
+     *
+     * @param region Wavetable index (0-8) or kNoiseRegion
+     * @return true if the region holds real sample data
+     */
+    bool isRegionReady(uint32_t region) const {
+        return region < kNumTotalFiles && (sets_[active_].readyMask & (1u << region)) != 0;
+    }
+
+    /**
+     * Report the wavetable this instance's strike exciter plays at its
+     * MALLET target (not the ramped value, whose intermediate steps would
+     * each pull in a table). Every instance calls it once per step(), before
+     * loadStep(); the driver collects the reports of one pass, so the
+     * wavetables of all instances (and the ones above them) are loaded and
+     * kept resident while others may be evicted. Pass -1 when the strike
+     * exciter doesn't use the sampled mallets.
+     *
+     * @param index Wavetable index (0-8) or -1
+     */
+    void setPreferredWavetable(int32_t index) {
+        if (index >= 0 && index < static_cast<int32_t>(kNumWavetables)) {
+            reportedMask_ |= static_cast<uint16_t>(1u << index);
+        }
+    }
+
+    /**
+     * Map the strike META (MALLET) value to the wavetable it plays.
+     *
+     * @param meta Patch exciter_strike_meta (0.0-1.0)
+     * @return Wavetable index (0-8), or -1 if the strike model is synthetic
+     */
+    static int32_t wavetableForStrikeMeta(float meta);
+
+    /**
+     * Progress of the region currently loading.
+     *
+     * @return Percent of its frames read, or of its samples resampled while
+     *         RESAMPLING (0-100)
      */
-    bool isLoaded() const { return loadState_ == LoadState::COMPLETE; }
+    uint32_t getLoadProgress() const;
 
     /**
      * Check current loading state.
@@ -119,46 +327,221 @@ public:
     LoadState getLoadState() const { return loadState_; }
 
 private:
-    // Validate folder contents (file names, formats)
-    bool validateFolder(uint32_t folderIndex);
+    static constexpr size_t kNoSlot = static_cast<size_t>(-1);
+
+    // One loaded sample bank. The exciter reads sets_[active_]; a bank
+    // switch fills the other set and then swaps.
+    struct SampleSet {
+        // Published wavetables (silentPage_ while not resident)
+        const Sample* wavetableData[kNumWavetables];
+        size_t wavetableSize[kNumWavetables];
+
+        // Slot pool bookkeeping
+        size_t slotOffset[kNumWavetables];      // Offset in pool_ (kNoSlot = none)
+        size_t slotLength[kNumWavetables];      // Samples reserved
+        uint32_t lastWanted[kNumWavetables];    // tick_ when last wanted (LRU)
+
+        Sample* noiseBuffer;        // Points into DRAM (after pool_)
+        const Sample* noiseSample;  // noiseBuffer + read lead, or silentPage_
+        uint16_t readyMask;         // Bit per region that is resident
+
+        // Boundary offsets of the wavetables in the source files
+        // boundaries[i] = start offset of wavetable i
+        // boundaries[9] = end offset (total size)
+        size_t boundaries[kNumBoundaries];
+
+        // Where the regions come from
+        int32_t bank;               // Sample bank held (folder suffix)
+        uint32_t folderIndex;
+        uint32_t fileIndices[kNumTotalFiles];   // Folder file index per region
+        bool useBank;               // Regions come from bank.wav
+        uint32_t bankFileIndex;
+        uint32_t bankFrames;
+    };
+
+    // Folder scan entries: the ten region files, then the bank
+    static constexpr uint32_t kBankEntry = kNumTotalFiles;
+    static constexpr uint32_t kNumExpectedNames = kNumTotalFiles + 1;
+
+    static uint32_t hashName(const char* name);
+    static const char* expectedName(uint32_t entry);
+    static bool entryFormatOk(uint32_t entry, const _NT_wavInfo& info);
+
+    // Start validating a folder (from the cache if it looks unchanged)
+    void beginValidation(uint32_t folderIndex);
+
+    // Re-check the files the cached validation found
+    bool checkCachedEntries();
+
+    // Match one folder entry against the expected names
+    void matchEntry(uint32_t fileIdx);
+
+    // Advance validation by a few folder entries
+    // Returns 1 when valid, 0 while scanning, -1 if invalid
+    int32_t validateStep();
+
+    // Copy the validated folder layout into the set being loaded
+    void adoptValidation();
+
+    // Check the bank header and adopt its boundaries
+    bool parseBankHeader();
+
+    // Issue a read of a file in the sample folder into dst
+    bool startRead(uint32_t sample, void* dst, uint32_t startOffset, uint32_t numFrames);
+
+    // 16-bit file frames holding `samples` stored samples
+    static uint32_t framesForSamples(size_t samples) {
+        return static_cast<uint32_t>((samples * sizeof(Sample) + 1) / 2);
+    }
+
+    // 2 = under MALLET of some instance, 1 = above one, 0 = not wanted
+    int wantRank(uint32_t wavetable) const;
 
-    // Start loading the next file in sequence
+    // Is the wavetable a preferred one or one above it?
+    bool isWanted(uint32_t wavetable) const;
+
+    // Pick the next region to load into the target set
+    // (kNumTotalFiles when nothing wanted is missing)
+    uint32_t selectNextFile() const;
+
+    // Select the next region, update the load state and start its read.
+    // Swaps in a staged bank once it has everything it needs first.
+    // Returns false if the read could not be started
+    bool beginNextRegion();
+
+    // Start loading the region in currentFileIndex_
     bool startNextLoad();
 
-    // Find the "elements" sample folder index
+    // Read the next chunk of the current region
+    bool startNextChunk();
+
+    // Publish the region in currentFileIndex_ to the target set
+    void publishRegion();
+
+#ifdef NT_ELEMENTS_RESAMPLE_SAMPLES
+    // Source samples per host sample (Q16), 0 when no resampling is needed
+    static uint32_t hostRateStep();
+
+    // Samples a region of `samples` source samples resamples to
+    static size_t resampledLength(size_t samples, uint32_t step);
+
+    // Resample the next block of the current wavetable in place
+    // Returns true when the whole wavetable is done
+    bool resampleBlock();
+
+    // Reload the resident wavetables if the host rate changed
+    void checkHostRate();
+#endif
+
+    // Reserve pool space for a wavetable of the target set, evicting
+    // others (from either set) as needed. Returns the slot offset in samples,
+    // or kNoSlot if only wavetables wanted as much could make room
+    size_t allocateSlot(uint32_t wavetable, size_t samples);
+
+    // Point a wavetable back at the silent page and free its slot
+    void evictWavetable(SampleSet& set, uint32_t wavetable);
+
+    // While staging a bank, point the playing set at the staged copy of a
+    // wavetable both hold and free the playing copy's slot. Returns false
+    // if there is none
+    bool handOverWavetable();
+
+    // Unpublish every region of a set and free its slots
+    void releaseSet(SampleSet& set);
+
+    // Start loading requestedBank_ (into the idle set if the playing one has data)
+    void beginBankSwitch();
+
+    // Find the sample folder of a bank
     // Returns -1 if not found
-    int32_t findSampleFolder() const;
+    int32_t findSampleFolder(int32_t bank) const;
 
-    // Callback for async WAV loading
+    // Callback for async WAV loading, one per entry of requests_; a callback
+    // for a request that was given up on is ignored
+    template <uint32_t kRequest>
     static void onSampleLoaded(void* userData, bool success);
 
+    // Give up on the read in flight: its callback, if it ever comes, is
+    // ignored and the next read uses the other request structure
+    void abandonRequest();
+
+    // Advance the state machine (driver instance only)
+    bool advance();
+
+    // Enter FAILED and schedule a retry
+    void failLoad();
+
     // DRAM buffer pointers
-    int16_t* sampleData_;       // Points into DRAM (9 wavetables)
-    int16_t* noiseSample_;      // Points into DRAM (after sampleData_)
+    Sample* pool_;              // Points into DRAM (wavetable slots)
+    Sample* silentPage_;        // Points into DRAM (after the noise buffers), silent
 
-    // Precomputed boundary offsets for wavetables
-    // boundaries_[i] = start offset of wavetable i
-    // boundaries_[9] = end offset (total size)
-    size_t boundaries_[kNumBoundaries];
+    // Sample sets
+    SampleSet sets_[kNumSets];
+    uint32_t active_;               // Set the exciter reads
+    uint32_t target_;               // Set being loaded (active_ unless switching banks)
+    int32_t requestedBank_;         // From setSampleBank()
+    uint32_t tick_;                 // Bumped when the preferences move
 
-    // Persistent WAV request (must persist until callback)
-    _NT_wavRequest currentRequest_;
+    // WAV requests (each must persist until its callback). A request given
+    // up on is left to the host and the next read uses the other one.
+    _NT_wavRequest requests_[2];
+    uint32_t request_;              // Index of the request in use
 
     // Loading state machine
     LoadState loadState_;
-    uint32_t folderIndex_;          // Cached folder index once found
-    uint32_t currentFileIndex_;     // Which file we're loading (0-8 wavetables, 9 = noise)
+    uint32_t currentFileIndex_;     // Which region we're loading (0-8 wavetables, 9 = noise)
+    size_t currentLead_;            // Samples before the region in the read (odd mu-law offsets)
+    uint32_t regionSource_;         // Folder file index the region is read from
+    uint8_t* regionDst_;            // Where the region's first frame lands
+    uint32_t regionStartFrame_;     // First frame of the region in its file
+    uint32_t regionFrames_;         // Frames to read for the region
+    uint32_t regionFramesDone_;     // Frames read so far
+    uint32_t chunkFrames_;          // Frames in the chunk in flight
+    uint32_t chunkRetries_;         // Re-reads of the current chunk
+    size_t regionSamples_;          // Samples published for the region
+    bool draining_;                 // Cancelled; waiting for the in-flight chunk
+    uint32_t drainCounter_;
+    uint16_t reportedMask_;         // Wavetables under MALLET reported since the last driver pass
+    uint16_t preferredMask_;        // Wavetables under MALLET of all instances
+    uint16_t deferredMask_;         // Wanted wavetables that did not fit in the pool
     volatile bool callbackPending_; // True if waiting for callback
     volatile bool callbackSuccess_; // Result from last callback
 
+#ifdef NT_ELEMENTS_RESAMPLE_SAMPLES
+    // Wavetable resampling
+    uint32_t preparedStep_;         // hostRateStep() the resident wavetables use
+    size_t resampleSource_;         // Source samples of the wavetable being resampled
+    size_t resampleRemaining_;      // Output samples still to write (back to front)
+#endif
+
     // Retry state
     uint32_t retryCount_;
     uint32_t retryDelayCounter_;
 
-    // File index mapping (maps expected file index to actual folder file index)
-    // fileIndices_[0] = folder index of wavetable_00.wav
-    // fileIndices_[9] = folder index of noise.wav
-    uint32_t fileIndices_[kNumTotalFiles];
+    // Incremental folder validation
+    uint32_t expectedHashes_[kNumExpectedNames];
+    uint32_t scanIndex_;            // Next folder entry to examine
+    uint32_t scanNumFiles_;
+    uint16_t scanFound_;            // Bit per expected name found
+    bool scanBadFormat_;            // An expected file had the wrong format
+    bool scanFromCache_;
+
+    // Result of the last good validation (file index and length per expected
+    // name); survives reset() so a remount of the same card skips the scan
+    uint32_t foundIndices_[kNumExpectedNames];
+    uint32_t foundFrames_[kNumExpectedNames];
+    bool cacheValid_;
+    uint32_t cacheFolderIndex_;
+    uint32_t cacheNumFiles_;
+    bool cacheUseBank_;
+
+    // Packed bank header being read
+    int16_t bankHeader_[kBankHeaderFrames];
+
+    // Shared-use state: the instance driving the loader and SD mount tracking
+    const void* driver_;
+    uint32_t driverMissedCalls_;
+    bool sdWasMounted_;
 };
 
 #endif // SAMPLE_MANAGER_H
@@ -0,0 +1,171 @@
+/*
+ * lut_bench.cpp - Accuracy and speed of the fast_math.h polynomials against
+ * the lut_generator.cpp tables
+ *
+ * For each replaced lookup, measures over a sweep of its input range:
+ *   - maximum error of the table lookup and of the polynomial against a
+ *     double-precision reference
+ *   - maximum deviation of the polynomial from the table lookup
+ *   - time per call of each (cycles from the TSC on x86, else nanoseconds)
+ *
+ * The host runs with every table in L1 cache, which flatters the tables:
+ * on the module they are read from DTC or DRAM (see s_hotTables in
+ * lut_generator.cpp). Treat the host speedups as a lower bound.
+ *
+ * Usage: make lut-bench
+ *
+ * Copyright (c) 2025 Neal Sanche
+ * Licensed under MIT License
+ */
+
+#include "../src/lut_generator.h"
+#include "../src/fast_math.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace elements {
+extern const float* lut_sine;
+extern const float* lut_approx_svf_g;
+}
+
+namespace stmlib {
+extern const float* lut_pitch_ratio_high;
+extern const float* lut_pitch_ratio_low;
+}
+
+static const int kNumInputs = 4096;
+static const int kRepeats = 2000;
+static const uint32_t kBenchSampleRate = 48000;
+
+// ------------------------------------------------------------------
+// Table lookups, as the DSP does them (stmlib/dsp/units.h, dsp.h)
+// ------------------------------------------------------------------
+
+static inline float tableInterpolate(const float* table, float index, float size) {
+    index *= size;
+    const int32_t integral = static_cast<int32_t>(index);
+    const float fractional = index - static_cast<float>(integral);
+    const float a = table[integral];
+    const float b = table[integral + 1];
+    return a + (b - a) * fractional;
+}
+
+static inline float tableSemitonesToRatio(float semitones) {
+    const float pitch = semitones + 128.0f;
+    const int32_t integral = static_cast<int32_t>(pitch);
+    const float fractional = pitch - static_cast<float>(integral);
+    return stmlib::lut_pitch_ratio_high[integral] *
+        stmlib::lut_pitch_ratio_low[static_cast<int32_t>(fractional * 256.0f)];
+}
+
+// ------------------------------------------------------------------
+// Timing
+// ------------------------------------------------------------------
+
+#if defined(__x86_64__) || defined(__i386__)
+static const char* kTimeUnit = "cycles";
+static inline uint64_t now() {
+    return __rdtsc();
+}
+#else
+static const char* kTimeUnit = "ns";
+static inline uint64_t now() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+#endif
+
+// Keeps the timed loops from being optimised away
+static volatile float s_sink;
+
+template <typename Fn>
+static double timePerCall(const std::vector<float>& inputs, Fn fn) {
+    float sum = 0.0f;
+    const uint64_t start = now();
+    for (int r = 0; r < kRepeats; ++r) {
+        for (int i = 0; i < kNumInputs; ++i) {
+            sum += fn(inputs[i]);
+        }
+    }
+    const uint64_t elapsed = now() - start;
+    s_sink = sum;
+    return static_cast<double>(elapsed) / (static_cast<double>(kRepeats) * kNumInputs);
+}
+
+// ------------------------------------------------------------------
+// Report
+// ------------------------------------------------------------------
+
+template <typename Table, typename Poly, typename Ref>
+static void bench(const char* name, float lo, float hi, bool relative,
+                  Table table, Poly poly, Ref reference) {
+    std::vector<float> inputs(kNumInputs);
+    for (int i = 0; i < kNumInputs; ++i) {
+        inputs[i] = lo + (hi - lo) * static_cast<float>(i) / (kNumInputs - 1);
+    }
+
+    // Error sweep is denser than the timing inputs
+    double tableErr = 0.0;
+    double polyErr = 0.0;
+    double deviation = 0.0;
+    const int kSweep = 1 << 20;
+    for (int i = 0; i <= kSweep; ++i) {
+        const float x = lo + (hi - lo) * static_cast<float>(i) / kSweep;
+        const double ref = reference(static_cast<double>(x));
+        const double t = table(x);
+        const double p = poly(x);
+        const double scale = relative ? std::fabs(ref) : 1.0;
+        tableErr = std::fmax(tableErr, std::fabs(t - ref) / scale);
+        polyErr = std::fmax(polyErr, std::fabs(p - ref) / scale);
+        deviation = std::fmax(deviation, std::fabs(p - t) / scale);
+    }
+
+    const double tableTime = timePerCall(inputs, table);
+    const double polyTime = timePerCall(inputs, poly);
+
+    printf("%s\n", name);
+    printf("  max %s error: table %.3e, polynomial %.3e (deviation from table %.3e)\n",
+           relative ? "relative" : "absolute", tableErr, polyErr, deviation);
+    printf("  %s/call: table %.2f, polynomial %.2f (%+.2f saved)\n",
+           kTimeUnit, tableTime, polyTime, tableTime - polyTime);
+}
+
+int main() {
+    std::vector<uint8_t> block(lutGeneratorTotalBytes());
+    lutGeneratorInit(block.data(), kBenchSampleRate);
+
+    const float oneOverSampleRate = 1.0f / kBenchSampleRate;
+    const double kPi = 3.14159265358979323846;
+
+    printf("LUT vs polynomial, %u Hz tables\n\n", static_cast<unsigned>(kBenchSampleRate));
+
+    bench("SemitonesToRatio (lut_pitch_ratio_high/low)", -127.0f, 127.0f, true,
+          [](float s) { return tableSemitonesToRatio(s); },
+          [](float s) { return fastSemitonesToRatio(s); },
+          [](double s) { return std::pow(2.0, s / 12.0); });
+
+    bench("Sine (lut_sine)", 0.0f, 0.9999f, false,
+          [](float x) { return tableInterpolate(elements::lut_sine, x, 4096.0f); },
+          [](float x) { return fastSine2Pi(x); },
+          [kPi](double x) { return std::sin(2.0 * kPi * x); });
+
+    bench("SVF g (lut_approx_svf_g)", 0.0f, 0.9999f, true,
+          [](float x) { return tableInterpolate(elements::lut_approx_svf_g, x, 256.0f); },
+          [oneOverSampleRate](float x) { return fastSvfG(x, oneOverSampleRate); },
+          [kPi](double x) {
+              double f = 32.0 * std::pow(10.0, 2.7 * x) / kBenchSampleRate;
+              if (f > 0.499) {
+                  f = 0.499;
+              }
+              return std::tan(kPi * f);
+          });
+
+    return 0;
+}
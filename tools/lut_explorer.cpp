@@ -0,0 +1,263 @@
+/*
+ * lut_explorer.cpp - LUT fidelity check and size explorer for nt_elements
+ *
+ * 1. Fidelity: compares every table lut_generator.cpp builds (at 32kHz, the
+ *    rate the originals were computed for) entry by entry against the
+ *    original constant tables in src/resources_extracted.cc. The stmlib pitch
+ *    ratio tables aren't in that file and are checked against their closed
+ *    form (2^((i - 128) / 12) and 2^(i / 3072)).
+ *
+ * 2. Size sweep: for each smooth table, keeps every 2nd/4th/8th/16th entry
+ *    and reports the worst error of linear (what the DSP does today) and
+ *    cubic Catmull-Rom interpolation of the smaller table, next to the error
+ *    of today's full table, and the static DRAM each size would save.
+ *    Errors are measured at 8 points per original interval against a cubic
+ *    interpolation of the full table.
+ *
+ * Exits non-zero if any generated table differs from its original by more
+ * than kTolerance (relative to the table's largest magnitude).
+ *
+ * Usage: make lut-explore
+ *
+ * Copyright (c) 2025 Neal Sanche
+ * Licensed under MIT License
+ */
+
+#include "../src/lut_generator.h"
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// The original tables, wrapped in their own namespace so they don't clash
+// with the lut_generator.cpp pointers of the same names. The include guard
+// keeps the Elements header (and its pointer declarations) out.
+#define ELEMENTS_RESOURCES_H_
+namespace original {
+#include "../src/resources_extracted.cc"
+}
+
+namespace elements {
+extern const int16_t* lut_db_led_brightness;
+extern const float* lut_sine;
+extern const float* lut_approx_svf_gain;
+extern const float* lut_approx_svf_g;
+extern const float* lut_approx_svf_r;
+extern const float* lut_approx_svf_h;
+extern const float* lut_4_decades;
+extern const float* lut_accent_gain_coarse;
+extern const float* lut_accent_gain_fine;
+extern const float* lut_stiffness;
+extern const float* lut_env_increments;
+extern const float* lut_env_linear;
+extern const float* lut_env_expo;
+extern const float* lut_env_quartic;
+extern const float* lut_midi_to_f_high;
+extern const float* lut_midi_to_increment_high;
+extern const float* lut_midi_to_f_low;
+extern const float* lut_fm_frequency_quantizer;
+extern const float* lut_detune_quantizer;
+extern const float* lut_svf_shift;
+}
+
+namespace stmlib {
+extern const float* lut_pitch_ratio_high;
+extern const float* lut_pitch_ratio_low;
+}
+
+// Originals are printed with 10 significant digits from double precision;
+// the generator computes in float
+static const double kTolerance = 1e-5;
+
+// Sets of the rate-dependent tables kept in DRAM (3 cached rates + spare)
+static const int kRateSets = 4;
+
+static const int kSweepStrides[] = { 2, 4, 8, 16 };
+static const int kPointsPerInterval = 8;
+
+struct TableInfo {
+    const char* name;
+    const float* const* generated;  // lut_generator.cpp pointer
+    const float* original;          // Original table
+    int size;                       // Entries, including any guard entry
+    int points;                     // Interpolated span + 1 (0 = don't sweep)
+    bool rateDependent;             // Kept once per rate set
+};
+
+// ------------------------------------------------------------------
+// Fidelity
+// ------------------------------------------------------------------
+
+static bool checkTable(const char* name, const float* generated, const float* original, int size) {
+    double peak = 0.0;
+    for (int i = 0; i < size; ++i) {
+        peak = std::fmax(peak, std::fabs(static_cast<double>(original[i])));
+    }
+    if (peak == 0.0) {
+        peak = 1.0;
+    }
+
+    double worst = 0.0;
+    int worstIndex = 0;
+    for (int i = 0; i < size; ++i) {
+        const double diff = std::fabs(static_cast<double>(generated[i]) - original[i]);
+        if (diff > worst) {
+            worst = diff;
+            worstIndex = i;
+        }
+    }
+
+    const bool ok = worst / peak <= kTolerance;
+    printf("  %-28s %5d  max diff %.3e (%.2e of peak) at [%d]%s\n",
+           name, size, worst, worst / peak, worstIndex, ok ? "" : "  MISMATCH");
+    return ok;
+}
+
+static bool checkInt16Table(const char* name, const int16_t* generated, const int16_t* original, int size) {
+    int worst = 0;
+    int worstIndex = 0;
+    for (int i = 0; i < size; ++i) {
+        const int diff = std::abs(generated[i] - original[i]);
+        if (diff > worst) {
+            worst = diff;
+            worstIndex = i;
+        }
+    }
+
+    // Rounding can move an entry by one code
+    const bool ok = worst <= 1;
+    printf("  %-28s %5d  max diff %d at [%d]%s\n",
+           name, size, worst, worstIndex, ok ? "" : "  MISMATCH");
+    return ok;
+}
+
+// ------------------------------------------------------------------
+// Size sweep
+// ------------------------------------------------------------------
+
+// Catmull-Rom through t[i-1..i+2], with the ends extended linearly
+static double cubicAt(const std::vector<double>& t, double position) {
+    const int last = static_cast<int>(t.size()) - 1;
+    int i = static_cast<int>(position);
+    if (i >= last) {
+        i = last - 1;
+    }
+    const double f = position - i;
+    const double p1 = t[i];
+    const double p2 = t[i + 1];
+    const double p0 = i > 0 ? t[i - 1] : 2.0 * p1 - p2;
+    const double p3 = i + 2 <= last ? t[i + 2] : 2.0 * p2 - p1;
+    return p1 + 0.5 * f * (p2 - p0 + f * (2.0 * p0 - 5.0 * p1 + 4.0 * p2 - p3 +
+        f * (3.0 * (p1 - p2) + p3 - p0)));
+}
+
+static double linearAt(const std::vector<double>& t, double position) {
+    const int last = static_cast<int>(t.size()) - 1;
+    int i = static_cast<int>(position);
+    if (i >= last) {
+        i = last - 1;
+    }
+    const double f = position - i;
+    return t[i] + (t[i + 1] - t[i]) * f;
+}
+
+static void sweepTable(const TableInfo& info) {
+    const float* table = *info.generated;
+    std::vector<double> full(table, table + info.points);
+    const int intervals = info.points - 1;
+
+    double peak = 0.0;
+    for (int i = 0; i < info.points; ++i) {
+        peak = std::fmax(peak, std::fabs(full[i]));
+    }
+
+    // Worst error of a table with the given stride, relative to the peak
+    auto worstError = [&](int stride, bool cubic) {
+        std::vector<double> reduced;
+        for (int i = 0; i <= intervals; i += stride) {
+            reduced.push_back(full[i]);
+        }
+        double worst = 0.0;
+        const int steps = intervals * kPointsPerInterval;
+        for (int s = 0; s <= steps; ++s) {
+            const double position = static_cast<double>(s) / kPointsPerInterval;
+            const double reference = cubicAt(full, position);
+            const double value = cubic ? cubicAt(reduced, position / stride) :
+                linearAt(reduced, position / stride);
+            worst = std::fmax(worst, std::fabs(value - reference));
+        }
+        return worst / peak;
+    };
+
+    const int copies = info.rateDependent ? kRateSets : 1;
+    printf("  %s (%d points%s): today linear %.2e\n", info.name, info.points,
+           info.rateDependent ? ", x4 rate sets" : "", worstError(1, false));
+    for (size_t k = 0; k < sizeof(kSweepStrides) / sizeof(kSweepStrides[0]); ++k) {
+        const int stride = kSweepStrides[k];
+        if (intervals % stride != 0) {
+            continue;
+        }
+        const int points = intervals / stride + 1;
+        const int saved = (info.points - points) * static_cast<int>(sizeof(float)) * copies;
+        printf("    %5d points  linear %.2e  cubic %.2e  saves %6d bytes\n",
+               points, worstError(stride, false), worstError(stride, true), saved);
+    }
+}
+
+int main() {
+    std::vector<uint8_t> block(lutGeneratorTotalBytes());
+    lutGeneratorInit(block.data(), 32000);
+
+    // Closed-form originals for the stmlib tables (stmlib/dsp/units.cc)
+    std::vector<float> pitchRatioHigh(257);
+    std::vector<float> pitchRatioLow(257);
+    for (int i = 0; i < 257; ++i) {
+        pitchRatioHigh[i] = static_cast<float>(std::pow(2.0, (i - 128) / 12.0));
+        pitchRatioLow[i] = static_cast<float>(std::pow(2.0, i / 256.0 / 12.0));
+    }
+
+    const TableInfo tables[] = {
+        { "lut_sine", &elements::lut_sine, original::elements::lut_sine, 4097, 4097, false },
+        { "lut_approx_svf_gain", &elements::lut_approx_svf_gain, original::elements::lut_approx_svf_gain, 257, 0, true },
+        { "lut_approx_svf_g", &elements::lut_approx_svf_g, original::elements::lut_approx_svf_g, 257, 257, true },
+        { "lut_approx_svf_r", &elements::lut_approx_svf_r, original::elements::lut_approx_svf_r, 257, 257, true },
+        { "lut_approx_svf_h", &elements::lut_approx_svf_h, original::elements::lut_approx_svf_h, 257, 257, true },
+        { "lut_4_decades", &elements::lut_4_decades, original::elements::lut_4_decades, 257, 257, false },
+        { "lut_accent_gain_coarse", &elements::lut_accent_gain_coarse, original::elements::lut_accent_gain_coarse, 257, 257, false },
+        { "lut_accent_gain_fine", &elements::lut_accent_gain_fine, original::elements::lut_accent_gain_fine, 257, 257, false },
+        { "lut_stiffness", &elements::lut_stiffness, original::elements::lut_stiffness, 257, 0, false },
+        { "lut_env_increments", &elements::lut_env_increments, original::elements::lut_env_increments, 258, 257, true },
+        { "lut_env_linear", &elements::lut_env_linear, original::elements::lut_env_linear, 258, 257, false },
+        { "lut_env_expo", &elements::lut_env_expo, original::elements::lut_env_expo, 258, 257, false },
+        { "lut_env_quartic", &elements::lut_env_quartic, original::elements::lut_env_quartic, 258, 257, false },
+        { "lut_midi_to_f_high", &elements::lut_midi_to_f_high, original::elements::lut_midi_to_f_high, 256, 0, true },
+        { "lut_midi_to_increment_high", &elements::lut_midi_to_increment_high, original::elements::lut_midi_to_increment_high, 256, 0, true },
+        { "lut_midi_to_f_low", &elements::lut_midi_to_f_low, original::elements::lut_midi_to_f_low, 256, 0, false },
+        { "lut_fm_frequency_quantizer", &elements::lut_fm_frequency_quantizer, original::elements::lut_fm_frequency_quantizer, 129, 0, false },
+        { "lut_detune_quantizer", &elements::lut_detune_quantizer, original::elements::lut_detune_quantizer, 65, 0, false },
+        { "lut_svf_shift", &elements::lut_svf_shift, original::elements::lut_svf_shift, 257, 257, false },
+        { "lut_pitch_ratio_high", &stmlib::lut_pitch_ratio_high, pitchRatioHigh.data(), 257, 257, false },
+        { "lut_pitch_ratio_low", &stmlib::lut_pitch_ratio_low, pitchRatioLow.data(), 257, 257, false },
+    };
+    const int numTables = sizeof(tables) / sizeof(tables[0]);
+
+    printf("Fidelity: lut_generator.cpp (32000 Hz) vs original tables\n");
+    bool ok = true;
+    for (int i = 0; i < numTables; ++i) {
+        ok &= checkTable(tables[i].name, *tables[i].generated, tables[i].original, tables[i].size);
+    }
+    ok &= checkInt16Table("lut_db_led_brightness", elements::lut_db_led_brightness,
+                          original::elements::lut_db_led_brightness, 513);
+
+    printf("\nSize sweep: worst error relative to the table's peak\n");
+    for (int i = 0; i < numTables; ++i) {
+        if (tables[i].points) {
+            sweepTable(tables[i]);
+        }
+    }
+
+    printf("\n%s\n", ok ? "All tables match the originals" : "Some tables differ from the originals");
+    return ok ? 0 : 1;
+}
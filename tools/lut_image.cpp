@@ -0,0 +1,93 @@
+/*
+ * lut_image.cpp - Writes the precomputed LUT image (luts.wav) for nt_elements
+ *
+ * Runs lutGeneratorInit() on the host and stores the resulting DRAM block,
+ * behind a LutImageHeader, as the data of a mono 16-bit WAV file: the disting
+ * NT can only read sample frames from the card, so the image rides in a WAV
+ * container. Build with the same SAMPLE_STORAGE option as the plugin (the
+ * header records the layout flags; a mismatched image is ignored on load).
+ *
+ * Usage: make lut-image [LUT_IMAGE=samples/elements/luts.wav]
+ *
+ * Copyright (c) 2025 Neal Sanche
+ * Licensed under MIT License
+ */
+
+#include "../src/lut_generator.h"
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static void put16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back(v & 0xFF);
+    out.push_back(v >> 8);
+}
+
+static void put32(std::vector<uint8_t>& out, uint32_t v) {
+    put16(out, v & 0xFFFF);
+    put16(out, v >> 16);
+}
+
+static void putTag(std::vector<uint8_t>& out, const char* tag) {
+    out.insert(out.end(), tag, tag + 4);
+}
+
+int main(int argc, char** argv) {
+    const char* path = argc > 1 ? argv[1] : "samples/elements/luts.wav";
+
+    const size_t imageBytes = lutGeneratorTotalBytes();
+    const size_t totalBytes = sizeof(LutImageHeader) + imageBytes;
+    if (totalBytes & 1) {
+        fprintf(stderr, "LUT block is %zu bytes; the image needs whole 16-bit frames\n", imageBytes);
+        return 1;
+    }
+
+    // The rate only selects which cached set the pointers use; every cached
+    // set is written into the block regardless
+    std::vector<uint8_t> block(totalBytes, 0);
+    uint8_t* image = block.data() + sizeof(LutImageHeader);
+    lutGeneratorInit(image, 32000);
+
+    LutImageHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = kLutImageMagic;
+    header.version = kLutImageVersion;
+    header.flags = lutImageFlags();
+    header.imageBytes = static_cast<uint32_t>(imageBytes);
+    header.checksum = lutImageChecksum(image, imageBytes);
+    memcpy(block.data(), &header, sizeof(header));
+
+    // Canonical 44-byte WAV header, mono 16-bit; the rate is nominal
+    const uint32_t sampleRate = 48000;
+    std::vector<uint8_t> wav;
+    putTag(wav, "RIFF");
+    put32(wav, static_cast<uint32_t>(36 + totalBytes));
+    putTag(wav, "WAVE");
+    putTag(wav, "fmt ");
+    put32(wav, 16);
+    put16(wav, 1);                  // PCM
+    put16(wav, 1);                  // Mono
+    put32(wav, sampleRate);
+    put32(wav, sampleRate * 2);     // Byte rate
+    put16(wav, 2);                  // Block align
+    put16(wav, 16);                 // Bits per sample
+    putTag(wav, "data");
+    put32(wav, static_cast<uint32_t>(totalBytes));
+    wav.insert(wav.end(), block.begin(), block.end());
+
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        fprintf(stderr, "Cannot write %s\n", path);
+        return 1;
+    }
+    const bool ok = fwrite(wav.data(), 1, wav.size(), f) == wav.size();
+    if (fclose(f) != 0 || !ok) {
+        fprintf(stderr, "Error writing %s\n", path);
+        return 1;
+    }
+
+    printf("Wrote %s: %zu bytes of LUTs, version %u, flags 0x%04x, checksum 0x%08x\n",
+           path, imageBytes, header.version, header.flags, header.checksum);
+    return 0;
+}
@@ -0,0 +1,42 @@
+/*
+ * memory_report.cpp - Per-instance DTC use of nt_elements
+ *
+ * Prints what calculateRequirements() asks for in DTC (the hot Part and the
+ * hot LUT copies that follow it) and what elements-part-cold-state.patch
+ * moved out of DTC into DRAM (PartColdState). Needs the patched Elements
+ * sources (make apply-patches).
+ *
+ * The host build has 8-byte pointers and size_t, so the Part (which holds
+ * references into PartColdState) measures a few bytes larger than on the
+ * module; the String and OminousVoice state is floats and matches.
+ *
+ * Usage: make memory-report
+ *
+ * Copyright (c) 2025 Neal Sanche
+ * Licensed under MIT License
+ */
+
+#include "../src/lut_generator.h"
+#include "elements/dsp/part.h"
+
+#include <cstdio>
+
+int main() {
+    const size_t part = sizeof(elements::Part);
+    const size_t cold = sizeof(elements::PartColdState);
+    const size_t luts = lutTierBytes(kLutTierDtc);
+    const size_t dtc = ((part + 7) & ~static_cast<size_t>(7)) + luts;
+
+    printf("DTC per instance:   %6u bytes\n", static_cast<unsigned>(dtc));
+    printf("  Part (hot state): %6u bytes\n", static_cast<unsigned>(part));
+    printf("  hot LUT copies:   %6u bytes\n", static_cast<unsigned>(luts));
+    printf("DTC saved:          %6u bytes (PartColdState, now in DRAM)\n",
+           static_cast<unsigned>(cold));
+    printf("  String models:    %6u bytes (%u x %u)\n",
+           static_cast<unsigned>(sizeof(elements::String) * elements::kNumStrings),
+           static_cast<unsigned>(elements::kNumStrings),
+           static_cast<unsigned>(sizeof(elements::String)));
+    printf("  OminousVoice:     %6u bytes\n",
+           static_cast<unsigned>(sizeof(elements::OminousVoice)));
+    return 0;
+}